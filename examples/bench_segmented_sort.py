@@ -0,0 +1,79 @@
+# Calibrates the segmented sort strategies of SortingKernels.h.
+#
+# Times torch.sort over rows of a [num_segments, num_elements] tensor with each
+# strategy forced by PYTORCH_XPU_SORT_STRATEGY, in a subprocess per strategy
+# since the variable is read once. The automatic choice should match the
+# fastest strategy in each row of the output.
+#
+# Usage: python bench_segmented_sort.py [--dtype float32] [--iters 20]
+
+import argparse
+import itertools
+import json
+import os
+import subprocess
+import sys
+
+STRATEGIES = ["auto", "bitonic", "group", "device"]
+NUM_SEGMENTS = [1, 64, 4096, 65536]
+NUM_ELEMENTS = [8, 16, 32, 64, 256, 1024, 2048, 4096, 8192, 65536]
+MAX_NUMEL = 1 << 28
+
+
+def measure(dtype, iters):
+    import torch
+
+    results = {}
+    for segs, n in itertools.product(NUM_SEGMENTS, NUM_ELEMENTS):
+        if segs * n > MAX_NUMEL:
+            continue
+        x = torch.randn(segs, n, device="xpu").to(getattr(torch, dtype))
+        torch.sort(x, stable=True)
+        torch.xpu.synchronize()
+        start = torch.xpu.Event(enable_timing=True)
+        end = torch.xpu.Event(enable_timing=True)
+        start.record()
+        for _ in range(iters):
+            torch.sort(x, stable=True)
+        end.record()
+        end.synchronize()
+        results[f"{segs}x{n}"] = start.elapsed_time(end) * 1e3 / iters
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser()
+    parser.add_argument("--dtype", default="float32")
+    parser.add_argument("--iters", type=int, default=20)
+    parser.add_argument("--child", action="store_true", help=argparse.SUPPRESS)
+    args = parser.parse_args()
+
+    if args.child:
+        print(json.dumps(measure(args.dtype, args.iters)))
+        return
+
+    timings = {}
+    for strategy in STRATEGIES:
+        env = dict(os.environ)
+        env.pop("PYTORCH_XPU_SORT_STRATEGY", None)
+        if strategy != "auto":
+            env["PYTORCH_XPU_SORT_STRATEGY"] = strategy
+        out = subprocess.run(
+            [sys.executable, __file__, "--child", "--dtype", args.dtype,
+             "--iters", str(args.iters)],
+            env=env, check=True, capture_output=True, text=True).stdout
+        timings[strategy] = json.loads(out.strip().splitlines()[-1])
+
+    # Strategies that cannot handle a shape fall back to the automatic choice,
+    # so equal timings in a row are expected.
+    print(f"{'shape':>14}" + "".join(f"{s + ' (us)':>16}" for s in STRATEGIES)
+          + f"{'fastest':>10}")
+    for shape in timings["auto"]:
+        row = [timings[s][shape] for s in STRATEGIES]
+        fastest = STRATEGIES[1 + min(range(3), key=lambda i: row[1 + i])]
+        print(f"{shape:>14}" + "".join(f"{t:16.1f}" for t in row)
+              + f"{fastest:>10}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,41 @@
+import torch
+from torch.testing._internal.common_utils import TestCase
+
+cpu_device = torch.device("cpu")
+xpu_device = torch.device("xpu")
+
+
+def embedding_bag_grads(device, weight, input, offsets, mode, psw, padding_idx):
+    weight = weight.to(device).requires_grad_()
+    if psw is not None:
+        psw = psw.to(device).requires_grad_()
+    out = torch.nn.functional.embedding_bag(
+        input.to(device),
+        weight,
+        offsets.to(device),
+        mode=mode,
+        per_sample_weights=psw,
+        padding_idx=padding_idx,
+    )
+    grad = torch.arange(out.numel(), dtype=out.dtype).view(out.shape) / 7
+    out.backward(grad.to(device))
+    grads = [weight.grad.cpu()]
+    if psw is not None:
+        grads.append(psw.grad.cpu())
+    return grads
+
+
+class TestTorchMethod(TestCase):
+    def test_embedding_bag_backward(self, dtype=torch.float):
+        weight = torch.randn([20, 33], dtype=dtype)
+        # Row 3 is hot, the bag at offset 9 is empty and row 0 is padding.
+        input = torch.tensor([3, 5, 3, 0, 3, 7, 3, 3, 19, 3, 1, 0, 3])
+        offsets = torch.tensor([0, 4, 9, 9])
+        for mode in ["sum", "mean", "max"]:
+            for padding_idx in [None, 0]:
+                psw = torch.randn([13], dtype=dtype) if mode == "sum" else None
+                args = (weight, input, offsets, mode, psw, padding_idx)
+                ref = embedding_bag_grads(cpu_device, *args)
+                out = embedding_bag_grads(xpu_device, *args)
+                for r, o in zip(ref, out):
+                    self.assertEqual(r, o)
@@ -94,3 +94,116 @@ class TestTorchMethod(TestCase):
         b = torch.randn([5, 0], dtype=dtype, device=torch.device("xpu"))
         a[:5, :] = a[:5, :] * 2 + b
         torch.use_deterministic_algorithms(False)
+
+    def test_index_out_of_bounds(self, dtype=torch.float):
+        x_xpu = torch.randn([4, 3], dtype=dtype, device=xpu_device)
+        torch.ops.torch_xpu_ops._check_index_errors()
+
+        index = torch.tensor([0, -4, 3], device=xpu_device)
+        self.assertEqual(x_xpu[index].cpu(), x_xpu.cpu()[index.cpu()])
+        torch.ops.torch_xpu_ops._check_index_errors()
+
+        index = torch.tensor([0, 4], device=xpu_device)
+        x_xpu.index_select(0, index)
+        with self.assertRaisesRegex(IndexError, "index 4 is out of bounds"):
+            torch.ops.torch_xpu_ops._check_index_errors()
+        torch.ops.torch_xpu_ops._check_index_errors()
+
+        index = torch.tensor([[0, 5, 1]], device=xpu_device)
+        torch.gather(x_xpu, 0, index)
+        with self.assertRaisesRegex(IndexError, "index 5 is out of bounds"):
+            torch.ops.torch_xpu_ops._check_index_errors()
+
+        index = torch.tensor([-5], device=xpu_device)
+        x_xpu[index] = 1.0
+        with self.assertRaisesRegex(IndexError, "index -5 is out of bounds"):
+            torch.ops.torch_xpu_ops._check_index_errors()
+
+        # A blocking copy to the host raises, and the output gathers from 0.
+        index = torch.tensor([0, 4], device=xpu_device)
+        y_xpu = x_xpu.index_select(0, index)
+        with self.assertRaisesRegex(IndexError, "index 4 is out of bounds"):
+            y_xpu.cpu()
+        self.assertEqual(y_xpu.cpu(), x_xpu.cpu()[[0, 0]])
+        x_xpu.index_select(0, index)
+        with self.assertRaisesRegex(IndexError, "index 4 is out of bounds"):
+            x_xpu.sum().item()
+
+    def test_index_put_accumulate_skewed(self, dtype=torch.float):
+        # Most updates hit row 3, spanning many sorted chunks.
+        index_cpu = torch.randint(0, 8, [5000])
+        index_cpu[torch.rand([5000]) < 0.9] = 3
+        values_cpu = torch.randn([5000, 17], dtype=dtype)
+        x_cpu = torch.randn([8, 17], dtype=dtype)
+        x_xpu = x_cpu.to(xpu_device)
+        x_cpu.index_put_([index_cpu], values_cpu, True)
+        x_xpu.index_put_(
+            [index_cpu.to(xpu_device)], values_cpu.to(xpu_device), True
+        )
+        self.assertEqual(x_cpu, x_xpu.cpu(), atol=1e-3, rtol=1e-4)
+
+    def test_scatter_add_collisions(self, dtype=torch.bfloat16):
+        # 64 updates per destination take the sorted, atomic-free path.
+        index_cpu = torch.randint(0, 4, [256, 32])
+        src_cpu = torch.randn([256, 32])
+        x_cpu = torch.zeros([4, 32])
+        ref = x_cpu.scatter_add(0, index_cpu, src_cpu)
+        out = x_cpu.to(xpu_device, dtype).scatter_add(
+            0, index_cpu.to(xpu_device), src_cpu.to(xpu_device, dtype)
+        )
+        self.assertEqual(ref, out.cpu().float(), atol=0.5, rtol=0.05)
+
+    def test_index_reduce(self, dtype=torch.float):
+        x_cpu = torch.randn([6, 5, 3], dtype=dtype)
+        src_cpu = torch.randn([6, 9, 3], dtype=dtype)
+        index_cpu = torch.tensor([0, 4, 1, 4, 0, 2, 4, 1, 0])
+        for reduce in ["prod", "mean", "amax", "amin"]:
+            for include_self in [True, False]:
+                ref = x_cpu.index_reduce(
+                    1, index_cpu, src_cpu, reduce, include_self=include_self
+                )
+                out = x_cpu.to(xpu_device).index_reduce_(
+                    1,
+                    index_cpu.to(xpu_device),
+                    src_cpu.to(xpu_device),
+                    reduce,
+                    include_self=include_self,
+                )
+                self.assertEqual(ref, out.cpu())
+
+        x_cpu = torch.randint(-10, 10, [7, 4])
+        src_cpu = torch.randint(-10, 10, [5, 4])
+        index_cpu = torch.tensor([6, 0, 6, 3, 0])
+        ref = x_cpu.index_reduce(0, index_cpu, src_cpu, "mean")
+        out = x_cpu.to(xpu_device).index_reduce(
+            0, index_cpu.to(xpu_device), src_cpu.to(xpu_device), "mean"
+        )
+        self.assertEqual(ref, out.cpu())
+
+    def test_index_copy(self, dtype=torch.float):
+        x_cpu = torch.randn([4, 6, 5], dtype=dtype)
+        src_cpu = torch.randn([4, 3, 5], dtype=dtype)
+        index_cpu = torch.tensor([5, 0, 2])
+        ref = x_cpu.index_copy(1, index_cpu, src_cpu)
+        out = x_cpu.to(xpu_device).index_copy_(
+            1, index_cpu.to(xpu_device), src_cpu.to(xpu_device)
+        )
+        self.assertEqual(ref, out.cpu())
+
+    def test_take_and_put(self, dtype=torch.float):
+        x_cpu = torch.randn([5, 7], dtype=dtype).t()
+        index_cpu = torch.tensor([[0, 34], [-1, 17]])
+        x_xpu = x_cpu.to(xpu_device)
+        self.assertEqual(
+            torch.take(x_cpu, index_cpu),
+            torch.take(x_xpu, index_cpu.to(xpu_device)).cpu(),
+        )
+
+        src_cpu = torch.randn([2, 2], dtype=dtype)
+        for accumulate in [False, True]:
+            index_cpu = torch.tensor([[3, 20], [-2, 3 if accumulate else 9]])
+            ref = x_cpu.clone().put_(index_cpu, src_cpu, accumulate)
+            out = x_xpu.clone().put_(
+                index_cpu.to(xpu_device), src_cpu.to(xpu_device), accumulate
+            )
+            self.assertEqual(ref, out.cpu())
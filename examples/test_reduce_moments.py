@@ -0,0 +1,45 @@
+import torch
+from torch.testing._internal.common_utils import TestCase
+
+
+class TestTorchMethod(TestCase):
+    def _test_complex_moments(self, dtype):
+        x = torch.randn(8, 33, 65, dtype=dtype)
+        x_xpu = x.xpu()
+        for dim in [None, 0, 1, 2, (0, 2)]:
+            for keepdim in [False, True]:
+                if dim is None and keepdim:
+                    continue
+                kwargs = {} if dim is None else {"dim": dim, "keepdim": keepdim}
+                for fn in [torch.var_mean, torch.std_mean]:
+                    ref = fn(x, **kwargs)
+                    res = fn(x_xpu, **kwargs)
+                    self.assertEqual(res[0].cpu(), ref[0])
+                    self.assertEqual(res[1].cpu(), ref[1])
+                for fn in [torch.var, torch.std]:
+                    self.assertEqual(fn(x_xpu, **kwargs).cpu(), fn(x, **kwargs))
+
+    def test_complex_moments_cfloat(self):
+        self._test_complex_moments(torch.cfloat)
+
+    def test_complex_moments_cdouble(self):
+        self._test_complex_moments(torch.cdouble)
+
+    def test_complex_moments_correction(self):
+        x = torch.randn(4, 1000, dtype=torch.cfloat)
+        for correction in [0, 1, 2]:
+            ref = torch.var_mean(x, dim=1, correction=correction)
+            res = torch.var_mean(x.xpu(), dim=1, correction=correction)
+            self.assertEqual(res[0].cpu(), ref[0])
+            self.assertEqual(res[1].cpu(), ref[1])
+
+    def test_histogram_bincount_extrema(self):
+        x = torch.randn(10000)
+        hist, edges = torch.histogram(x, bins=20)
+        hist_xpu, edges_xpu = torch.histogram(x.xpu(), bins=20)
+        self.assertEqual(edges_xpu.cpu(), edges)
+        self.assertEqual(hist_xpu.cpu(), hist)
+        idx = torch.randint(0, 100, (5000,))
+        self.assertEqual(torch.bincount(idx.xpu()).cpu(), torch.bincount(idx))
+        with self.assertRaises(RuntimeError):
+            torch.bincount(torch.tensor([1, -1, 2]).xpu())
@@ -0,0 +1,91 @@
+import torch
+from torch.testing._internal.common_utils import TestCase
+
+# Shapes covering the loop scan (many short rows, also rows sharing a
+# sub-group), the segment scan over a single long row, whose carriers are
+# scanned recursively, and scans over a strided dim.
+shapes = [
+    ((512, 300), 1),
+    ((20000, 5), 1),
+    ((1, 100000), 1),
+    ((3, 5000, 7), 1),
+    ((4000, 6), 0),
+]
+
+
+class TestTorchMethod(TestCase):
+    def test_cumsum_loop_scan(self):
+        # Rows whose length is, or is not, a multiple of the items each
+        # work-item scans, rows spanning several tiles, and views whose
+        # storage offset breaks vector alignment. Rows shorter than a
+        # sub-group share it.
+        for rows, n in [
+            (300, 3),
+            (100000, 1),
+            (100000, 3),
+            (50000, 17),
+            (300, 1000),
+            (300, 1001),
+            (2048, 20000),
+        ]:
+            x = torch.randint(-5, 5, (rows, n + 1), dtype=torch.int32)
+            for t in [x[:, :n], x[:, 1:]]:
+                ref = torch.cumsum(t, 1)
+                self.assertEqual(torch.cumsum(t.xpu(), 1).cpu(), ref)
+        x = torch.randn(1024, 4096)
+        ref = torch.cumsum(x.double(), 1).float()
+        self.assertEqual(torch.cumsum(x.xpu(), 1).cpu(), ref)
+        x = torch.randn(512, 777, dtype=torch.bfloat16)
+        ref = torch.cumprod(x.float().sign(), 1)
+        res = torch.cumprod(x.sign().xpu(), 1).cpu().float()
+        self.assertEqual(res, ref)
+
+    def test_cummax_cummin(self):
+        for shape, dim in shapes:
+            x = torch.randint(0, 10, shape).float()
+            for op in [torch.cummax, torch.cummin]:
+                ref = op(x, dim)
+                res = op(x.xpu(), dim)
+                self.assertEqual(res.values.cpu(), ref.values)
+                self.assertEqual(res.indices.cpu(), ref.indices)
+
+    def test_cummax_cummin_nan(self):
+        x = torch.randn(1, 50000)
+        x[0, 1000] = float("nan")
+        x[0, 30000] = float("nan")
+        for op in [torch.cummax, torch.cummin]:
+            ref = op(x, 1)
+            res = op(x.xpu(), 1)
+            self.assertEqual(res.values.cpu(), ref.values)
+            self.assertEqual(res.indices.cpu(), ref.indices)
+
+    def test_cummax_cummin_dtypes(self):
+        for dtype in [torch.bool, torch.uint8, torch.int64, torch.bfloat16]:
+            x = torch.randint(0, 2, (300, 200)).to(dtype)
+            for op in [torch.cummax, torch.cummin]:
+                ref = op(x, 1)
+                res = op(x.xpu(), 1)
+                self.assertEqual(res.values.cpu(), ref.values)
+                self.assertEqual(res.indices.cpu(), ref.indices)
+
+    def test_logcumsumexp(self):
+        for shape, dim in shapes:
+            x = torch.randn(shape) * 20
+            ref = torch.logcumsumexp(x.double(), dim).float()
+            self.assertEqual(torch.logcumsumexp(x.xpu(), dim).cpu(), ref)
+        x = torch.tensor([float("-inf"), float("-inf"), 0.0, float("inf"), 1.0])
+        self.assertEqual(
+            torch.logcumsumexp(x.xpu(), 0).cpu(), torch.logcumsumexp(x, 0)
+        )
+
+    def test_logcumsumexp_half_complex(self):
+        x = torch.randn(256, 500)
+        ref = torch.logcumsumexp(x, 1)
+        res = torch.logcumsumexp(x.half().xpu(), 1).cpu().float()
+        self.assertEqual(res, ref, atol=1e-2, rtol=1e-2)
+        x = torch.randn(256, 500, dtype=torch.cfloat)
+        ref = torch.logcumsumexp(x, 1)
+        self.assertEqual(torch.logcumsumexp(x.xpu(), 1).cpu(), ref)
+        out = torch.empty(0, device="xpu", dtype=torch.cfloat)
+        torch.logcumsumexp(x.xpu(), 1, out=out)
+        self.assertEqual(out.cpu(), ref)
@@ -0,0 +1,92 @@
+import torch
+import torch.nn.functional as F
+from torch.testing._internal.common_utils import TestCase
+
+
+class TestTorchMethod(TestCase):
+    def test_softmax_long_rows(self):
+        # Rows longer than the register path takes, and misaligned rows
+        for n in [131072, 131071, 50257]:
+            x = torch.randn(4, n) * 10
+            x_xpu = x.xpu()
+            self.assertEqual(F.softmax(x_xpu, -1).cpu(), F.softmax(x, -1))
+            self.assertEqual(F.log_softmax(x_xpu, -1).cpu(), F.log_softmax(x, -1))
+        x = torch.randn(3, 100003, dtype=torch.bfloat16)
+        self.assertEqual(F.softmax(x.xpu(), -1).cpu(), F.softmax(x, -1))
+
+    def test_softmax_long_rows_inf(self):
+        x = torch.randn(2, 131072)
+        x[0, 1000] = float("inf")
+        x[1, :] = float("-inf")
+        x[1, 5] = 0.0
+        self.assertEqual(F.softmax(x.xpu(), -1).cpu(), F.softmax(x, -1))
+
+    def test_log_softmax_nll_loss(self):
+        fused = torch.ops.torch_xpu_ops._log_softmax_nll_loss
+        x = torch.randn(16, 32000)
+        target = torch.randint(0, 32000, (16,))
+        target[3] = -100
+        weight = torch.rand(32000)
+        for reduction, value in [("none", 0), ("mean", 1), ("sum", 2)]:
+            ref = F.cross_entropy(x, target, reduction=reduction)
+            res = fused(x.xpu(), target.xpu(), None, value)
+            self.assertEqual(res.cpu(), ref)
+            ref = F.cross_entropy(x, target, weight=weight, reduction=reduction)
+            res = fused(x.xpu(), target.xpu(), weight.xpu(), value)
+            self.assertEqual(res.cpu(), ref)
+        ref = F.cross_entropy(x[0], target[0])
+        self.assertEqual(fused(x[0].xpu(), target[0].xpu()).cpu(), ref)
+
+    def test_masked_softmax(self):
+        B, H, L = 2, 4, 64
+        x = torch.randn(B, H, L, L)
+        # (B, H, L, L), (L, L) src mask and (B, L) key padding mask
+        for mask, mask_type in [
+            (torch.rand(B, H, L, L) > 0.7, 2),
+            (torch.rand(L, L) > 0.7, 0),
+            (torch.rand(B, L) > 0.7, 1),
+        ]:
+            if mask_type == 1:
+                full_mask = mask.view(B, 1, 1, L).expand(B, H, L, L)
+            else:
+                full_mask = mask.expand(B, H, L, L)
+            full_mask = full_mask.clone()
+            full_mask[0, 0, 3] = True
+            if mask_type == 2:
+                mask = full_mask
+            ref = F.softmax(x.masked_fill(full_mask, float("-inf")), -1)
+            ref = ref.masked_fill(full_mask, 0)
+            res = torch._masked_softmax(x.xpu(), mask.xpu(), 3, mask_type)
+            self.assertEqual(res.cpu(), ref)
+            if mask_type == 2:
+                self.assertEqual(res[0, 0, 3].cpu(), torch.zeros(L))
+
+    def test_masked_softmax_backward(self):
+        x = torch.randn(2, 3, 40, 40)
+        mask = torch.rand(2, 3, 40, 40) > 0.5
+        grad = torch.randn(2, 3, 40, 40)
+        out = torch._masked_softmax(x, mask, 3, 2)
+        ref = torch._masked_softmax_backward(grad, out, mask, 3)
+        res = torch._masked_softmax_backward(
+            grad.xpu(), out.xpu(), mask.xpu(), 3
+        )
+        self.assertEqual(res.cpu(), ref)
+
+    def test_masked_softmax_additive(self):
+        x = torch.randn(2, 4, 16, 128)
+        mask = torch.randn(2, 4, 16, 128)
+        mask[0, 0, 5] = float("-inf")
+        ref = F.softmax(x + mask, -1).nan_to_num(0.0)
+        res = torch._masked_softmax(x.xpu(), mask.xpu(), -1)
+        self.assertEqual(res.cpu(), ref)
+
+    def test_masked_softmax_mask_shape(self):
+        x = torch.randn(2, 4, 16, 16, device="xpu")
+        mask = torch.rand(2, 1, 16, 16, device="xpu") > 0.5
+        with self.assertRaisesRegex(RuntimeError, "Mask shape should match"):
+            torch._masked_softmax(x, mask, 3, 2)
+        with self.assertRaisesRegex(RuntimeError, "should be \\(B, L\\)"):
+            torch._masked_softmax(x, mask[:, 0, 0, :4], 3, 1)
+        out = torch._masked_softmax(x, mask.expand(x.shape).clone(), 3, 2)
+        with self.assertRaisesRegex(RuntimeError, "Mask shape should match"):
+            torch._masked_softmax_backward(x, out, mask, 3)
@@ -17,3 +17,55 @@ class TestNNMethod(TestCase):
         res1val_cpu, res1ind_cpu = torch.sort(x.cpu(), descending=True, stable=True)
         self.assertEqual(res1val, res1val_cpu.xpu())
         self.assertEqual(res1ind, res1ind_cpu.xpu())
+
+    def test_sort_short_segments(self, device=torch.device('xpu')):
+        # Segments up to a sub-group are sorted by the sub-group bitonic sort.
+        for n in [1, 2, 3, 7, 16, 17, 31, 32, 33]:
+            x = torch.randint(0, 4, (1000, n), device=device).float()
+            for descending in [False, True]:
+                res1val, res1ind = torch.sort(x, descending=descending, stable=True)
+                res1val_cpu, res1ind_cpu = torch.sort(
+                    x.cpu(), descending=descending, stable=True)
+                self.assertEqual(res1val, res1val_cpu.xpu())
+                self.assertEqual(res1ind, res1ind_cpu.xpu())
+
+    def check_topk(self, x, k, device=torch.device('xpu')):
+        for largest in [True, False]:
+            ref_val, _ = torch.topk(x, k, largest=largest, sorted=True)
+            for sorted_ in [True, False]:
+                val, ind = torch.topk(
+                    x.to(device), k, largest=largest, sorted=sorted_)
+                val, ind = val.cpu(), ind.cpu()
+                # Indices point at the values, each element is taken once.
+                self.assertEqual(x.gather(-1, ind), val)
+                self.assertEqual(
+                    ind.sort(-1).values.unique_consecutive(dim=-1).shape,
+                    ind.shape)
+                if not sorted_:
+                    val = val.sort(-1, descending=largest).values
+                self.assertEqual(val, ref_val)
+
+    def test_topk_radix_select(self):
+        # k > 256 takes the multi-group radix select.
+        x = torch.randn(3, 5000)
+        for k in [257, 1000, 5000]:
+            self.check_topk(x, k)
+        # Many keys equal to the k-th one.
+        self.check_topk(torch.randint(0, 8, (3, 5000)).float(), 1000)
+
+    def test_topk_chunked_wide_rows(self):
+        # Few wide rows with k <= 256 are selected in chunks.
+        x = torch.randn(2, 300000)
+        for k in [1, 16, 256]:
+            self.check_topk(x, k)
+        self.check_topk(torch.randint(0, 8, (2, 300000)).float(), 64)
+
+    def test_sort_few_segments(self, device=torch.device('xpu')):
+        # Few segments spanning several device radix tiles take the device
+        # radix sort, many take the group radix sort.
+        for segs in [2, 4096]:
+            x = torch.randint(0, 64, (segs, 3000), device=device).float()
+            res1val, res1ind = torch.sort(x, stable=True)
+            res1val_cpu, res1ind_cpu = torch.sort(x.cpu(), stable=True)
+            self.assertEqual(res1val, res1val_cpu.xpu())
+            self.assertEqual(res1ind, res1ind_cpu.xpu())
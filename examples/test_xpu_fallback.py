@@ -0,0 +1,96 @@
+import os
+import subprocess
+import sys
+import textwrap
+
+from torch.testing._internal.common_utils import TestCase
+
+
+# The fallback reads its environment variables when torch is loaded, so each
+# case runs in a fresh interpreter.
+def run_with_env(script, **env):
+    return subprocess.run(
+        [sys.executable, "-c", textwrap.dedent(script)],
+        env={**os.environ, **env},
+        capture_output=True,
+        text=True,
+    )
+
+
+class TestXPUFallback(TestCase):
+    def assertSucceeds(self, result):
+        self.assertEqual(result.returncode, 0, msg=result.stderr)
+
+    def test_async_fallback(self):
+        script = """
+            import torch
+
+            x = torch.randn(16, 33)
+            ref = torch.cumsum(x, 1)
+
+            # Out arguments are not copied to host, the op overwrites them.
+            out = torch.randn(16, 33, device="xpu")
+            torch.cumsum(x.xpu(), 1, out=out)
+            torch.testing.assert_close(out.cpu(), ref)
+            out = torch.empty(0, device="xpu")
+            torch.cumsum(x.xpu(), 1, out=out)
+            torch.testing.assert_close(out.cpu(), ref)
+
+            y = x.xpu()
+            y.cumsum_(1)
+            torch.testing.assert_close(y.cpu(), ref)
+
+            torch.testing.assert_close(
+                torch.histc(x.xpu(), bins=10).cpu(), torch.histc(x, bins=10)
+            )
+
+            # A device argument runs the op on CPU, and places its output.
+            out = torch.tril_indices(5, 4, 1, device="xpu")
+            assert out.device.type == "xpu", out.device
+            torch.testing.assert_close(out.cpu(), torch.tril_indices(5, 4, 1))
+        """
+        self.assertSucceeds(
+            run_with_env(
+                script,
+                PYTORCH_XPU_FALLBACK_ASYNC="1",
+                PYTORCH_XPU_FALLBACK_OP="cumsum.out,cumsum_",
+            )
+        )
+
+    def test_fallback_stats(self):
+        script = """
+            import torch
+
+            stats = torch.ops.torch_xpu_ops._fallback_stats
+            torch.ops.torch_xpu_ops._fallback_stats_reset()
+            x = torch.randn(1000, device="xpu")
+            for _ in range(3):
+                torch.histc(x, bins=10)
+            ops, calls, d2h_bytes, h2d_bytes, wall_time_us = stats()
+            i = ops.index("aten::histc")
+            assert calls[i] == 3, calls[i]
+            assert d2h_bytes[i] == 3 * x.nbytes, d2h_bytes[i]
+            assert h2d_bytes[i] == 3 * 10 * x.element_size(), h2d_bytes[i]
+            assert wall_time_us[i] > 0
+
+            torch.ops.torch_xpu_ops._fallback_stats_reset()
+            assert stats()[0] == []
+            torch.histc(x, bins=10)
+        """
+        result = run_with_env(script, PYTORCH_XPU_FALLBACK_PROFILE="1")
+        self.assertSucceeds(result)
+        self.assertIn("XPU CPU fallback summary", result.stderr)
+        self.assertIn("aten::histc", result.stderr)
+
+        # Without profiling nothing is recorded. A malformed value disables it
+        # instead of throwing.
+        script = """
+            import torch
+
+            torch.histc(torch.randn(1000, device="xpu"), bins=10)
+            assert torch.ops.torch_xpu_ops._fallback_stats()[0] == []
+        """
+        for value in ["0", "yes"]:
+            result = run_with_env(script, PYTORCH_XPU_FALLBACK_PROFILE=value)
+            self.assertSucceeds(result)
+            self.assertNotIn("XPU CPU fallback summary", result.stderr)
@@ -11,6 +11,7 @@
 #include <c10/xpu/XPUStream.h>
 
 #include <ATen/native/xpu/sycl/CopyKernel.h>
+#include <ATen/native/xpu/sycl/IndexAssert.h>
 #include <ATen/native/xpu/sycl/UnaryComplexKernels.h>
 #include <comm/SYCLContext.h>
 #include <comm/XPUGuard.h>
@@ -283,6 +284,9 @@ void _copy_xpu(TensorIterator& iter, bool non_blocking) {
   } else {
     auto e = q.memcpy(dst, src, nbytes);
     e.wait();
+    if (copy_kind == _D2H_) {
+      native::xpu::check_index_errors_after_sync();
+    }
   }
 
   if (iter.tensor(0).is_conj() != iter.tensor(1).is_conj()) {
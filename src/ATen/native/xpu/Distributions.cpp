@@ -257,7 +257,10 @@ Tensor& XPUNativeFunctions::multinomial_out(
   // https://github.com/pytorch/pytorch/issues/11931#issuecomment-625882503
   if (!with_replacement || n_sample == 1) {
     // Sanity checks on `self`.
-    auto is_valid = ((self.max() < INFINITY) & (self.min() >= 0)).item();
+    auto extrema = at::aminmax(self);
+    auto is_valid =
+        ((std::get<1>(extrema) < INFINITY) & (std::get<0>(extrema) >= 0))
+            .item();
     TORCH_CHECK(
         is_valid.to<bool>(),
         "probability tensor contains either `inf`, `nan` or element < 0");
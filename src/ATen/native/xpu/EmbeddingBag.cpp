@@ -97,4 +97,44 @@ Tensor XPUNativeFunctions::_embedding_bag_backward(
       padding_idx);
 }
 
+Tensor XPUNativeFunctions::_embedding_bag_dense_backward(
+    const Tensor& grad,
+    const Tensor& indices,
+    const Tensor& offset2bag,
+    const Tensor& bag_size,
+    const Tensor& maximum_indices,
+    int64_t num_weights,
+    bool scale_grad_by_freq,
+    int64_t mode,
+    const c10::optional<Tensor>& per_sample_weights_opt,
+    int64_t padding_idx) {
+  c10::MaybeOwned<Tensor> per_sample_weights_maybe_owned =
+      at::borrow_from_optional_tensor(per_sample_weights_opt);
+  const Tensor& per_sample_weights = *per_sample_weights_maybe_owned;
+
+  return native::xpu::_embedding_bag_dense_backward_kernel(
+      grad,
+      indices,
+      offset2bag,
+      bag_size,
+      maximum_indices,
+      num_weights,
+      scale_grad_by_freq,
+      mode,
+      per_sample_weights,
+      padding_idx);
+}
+
+Tensor XPUNativeFunctions::_embedding_bag_per_sample_weights_backward(
+    const Tensor& grad,
+    const Tensor& weight,
+    const Tensor& indices,
+    const Tensor& offsets,
+    const Tensor& offset2bag,
+    int64_t mode,
+    int64_t padding_idx) {
+  return native::xpu::_embedding_bag_per_sample_weights_backward_kernel(
+      grad, weight, indices, offsets, offset2bag, mode, padding_idx);
+}
+
 } // namespace at
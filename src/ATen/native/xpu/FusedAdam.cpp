@@ -0,0 +1,181 @@
+#include <ATen/native/ForeachUtils.h>
+#include <ATen/xpu/XPUNativeFunctions.h>
+
+#include <ATen/native/xpu/sycl/FusedAdamKernels.h>
+
+namespace at {
+
+namespace {
+
+// Optimizer states share dtype, device and layout with params. Grads may be
+// of a lower precision than fp32 params (master weights), so they are only
+// required to match device and layout.
+void check_fused_adam_inputs(
+    TensorList params,
+    TensorList grads,
+    TensorList exp_avgs,
+    TensorList exp_avg_sqs,
+    TensorList max_exp_avg_sqs,
+    TensorList state_steps,
+    const bool amsgrad) {
+  if (amsgrad) {
+    TORCH_CHECK(
+        at::native::check_fast_path_restrictions(
+            {params, exp_avgs, exp_avg_sqs, max_exp_avg_sqs}),
+        "params, exp_avgs, exp_avg_sqs, and max_exp_avg_sqs must have same dtype, device, and layout");
+  } else {
+    TORCH_CHECK(
+        at::native::check_fast_path_restrictions(
+            {params, exp_avgs, exp_avg_sqs}),
+        "params, exp_avgs, and exp_avg_sqs must have same dtype, device, and layout");
+  }
+  TORCH_CHECK(
+      params.size() == grads.size() && params.size() == state_steps.size(),
+      "params, grads and state_steps must have the same number of tensors");
+  for (size_t i = 0; i < params.size(); ++i) {
+    TORCH_CHECK(
+        grads[i].device() == params[i].device() &&
+            grads[i].layout() == params[i].layout() &&
+            grads[i].sizes() == params[i].sizes() &&
+            grads[i].strides() == params[i].strides(),
+        "params and grads must have same device, layout, sizes and strides");
+  }
+}
+
+void check_fused_adam_devices(
+    TensorList params,
+    const Tensor& lr,
+    const c10::optional<Tensor>& grad_scale,
+    const c10::optional<Tensor>& found_inf) {
+  // Devices are checked manually, `tensor_lr` overloads are not device
+  // checked by codegen.
+  Device param_device = params[0].device();
+  if (grad_scale.has_value()) {
+    TORCH_CHECK(
+        grad_scale->device() == param_device,
+        "grad_scale must be on the same XPU device as the params");
+  }
+  if (found_inf.has_value()) {
+    TORCH_CHECK(
+        found_inf->device() == param_device,
+        "found_inf must be on the same XPU device as the params");
+  }
+  TORCH_CHECK(
+      lr.device() == param_device,
+      "lr must be on the same XPU device as the params");
+}
+
+} // namespace
+
+#define FUSED_ADAM_OP(NAME, MODE)                                         \
+  void XPUNativeFunctions::NAME(                                          \
+      TensorList self,                                                    \
+      TensorList grads,                                                   \
+      TensorList exp_avgs,                                                \
+      TensorList exp_avg_sqs,                                             \
+      TensorList max_exp_avg_sqs,                                         \
+      TensorList state_steps,                                             \
+      double lr,                                                          \
+      double beta1,                                                       \
+      double beta2,                                                       \
+      double weight_decay,                                                \
+      double eps,                                                         \
+      bool amsgrad,                                                       \
+      bool maximize,                                                      \
+      const c10::optional<Tensor>& grad_scale,                            \
+      const c10::optional<Tensor>& found_inf) {                           \
+    check_fused_adam_inputs(                                              \
+        self,                                                             \
+        grads,                                                            \
+        exp_avgs,                                                         \
+        exp_avg_sqs,                                                      \
+        max_exp_avg_sqs,                                                  \
+        state_steps,                                                      \
+        amsgrad);                                                         \
+    native::xpu::fused_adam_kernel(                                       \
+        self,                                                             \
+        grads,                                                            \
+        exp_avgs,                                                         \
+        exp_avg_sqs,                                                      \
+        max_exp_avg_sqs,                                                  \
+        state_steps,                                                      \
+        lr,                                                               \
+        Tensor(),                                                         \
+        beta1,                                                            \
+        beta2,                                                            \
+        weight_decay,                                                     \
+        eps,                                                              \
+        amsgrad,                                                          \
+        maximize,                                                         \
+        grad_scale,                                                       \
+        found_inf,                                                        \
+        MODE);                                                            \
+  }                                                                       \
+                                                                          \
+  void XPUNativeFunctions::NAME(                                          \
+      TensorList self,                                                    \
+      TensorList grads,                                                   \
+      TensorList exp_avgs,                                                \
+      TensorList exp_avg_sqs,                                             \
+      TensorList max_exp_avg_sqs,                                         \
+      TensorList state_steps,                                             \
+      const Tensor& lr,                                                   \
+      double beta1,                                                       \
+      double beta2,                                                       \
+      double weight_decay,                                                \
+      double eps,                                                         \
+      bool amsgrad,                                                       \
+      bool maximize,                                                      \
+      const c10::optional<Tensor>& grad_scale,                            \
+      const c10::optional<Tensor>& found_inf) {                           \
+    if (lr.is_cpu()) {                                                    \
+      return XPUNativeFunctions::NAME(                                    \
+          self,                                                           \
+          grads,                                                          \
+          exp_avgs,                                                       \
+          exp_avg_sqs,                                                    \
+          max_exp_avg_sqs,                                                \
+          state_steps,                                                    \
+          lr.item<double>(),                                              \
+          beta1,                                                          \
+          beta2,                                                          \
+          weight_decay,                                                   \
+          eps,                                                            \
+          amsgrad,                                                        \
+          maximize,                                                       \
+          grad_scale,                                                     \
+          found_inf);                                                     \
+    }                                                                     \
+    check_fused_adam_devices(self, lr, grad_scale, found_inf);            \
+    check_fused_adam_inputs(                                              \
+        self,                                                             \
+        grads,                                                            \
+        exp_avgs,                                                         \
+        exp_avg_sqs,                                                      \
+        max_exp_avg_sqs,                                                  \
+        state_steps,                                                      \
+        amsgrad);                                                         \
+    native::xpu::fused_adam_kernel(                                       \
+        self,                                                             \
+        grads,                                                            \
+        exp_avgs,                                                         \
+        exp_avg_sqs,                                                      \
+        max_exp_avg_sqs,                                                  \
+        state_steps,                                                      \
+        /* lr */ 1.0,                                                     \
+        lr.to(kFloat),                                                    \
+        beta1,                                                            \
+        beta2,                                                            \
+        weight_decay,                                                     \
+        eps,                                                              \
+        amsgrad,                                                          \
+        maximize,                                                         \
+        grad_scale,                                                       \
+        found_inf,                                                        \
+        MODE);                                                            \
+  }
+
+FUSED_ADAM_OP(_fused_adam_, native::xpu::ADAM_MODE::ORIGINAL);
+FUSED_ADAM_OP(_fused_adamw_, native::xpu::ADAM_MODE::ADAMW);
+
+} // namespace at
@@ -0,0 +1,137 @@
+#include <ATen/native/ForeachUtils.h>
+#include <ATen/xpu/XPUNativeFunctions.h>
+
+#include <ATen/native/xpu/sycl/FusedSgdKernels.h>
+
+namespace at {
+
+namespace {
+
+void check_fused_sgd_inputs(
+    TensorList params,
+    TensorList grads,
+    TensorList momentum_buffer_list,
+    const double momentum,
+    const bool is_first_step) {
+  if (momentum_buffer_list.empty()) {
+    TORCH_CHECK_EQ(momentum, 0.0);
+    TORCH_CHECK(
+        at::native::check_fast_path_restrictions({params, grads}),
+        "params and grads must have same dtype, device, and layout");
+    if (is_first_step) {
+      TORCH_WARN_ONCE(
+          "`is_first_step` argument has no effect when `momentum_buffer_list` is empty");
+    }
+  } else {
+    TORCH_CHECK_GT(momentum, 0.0);
+    TORCH_CHECK(
+        at::native::check_fast_path_restrictions(
+            {params, grads, momentum_buffer_list}),
+        "params, grads, and momentum_buffer_list must have same dtype, device, and layout");
+  }
+}
+
+void check_fused_sgd_devices(
+    TensorList params,
+    const Tensor& lr,
+    const c10::optional<Tensor>& grad_scale,
+    const c10::optional<Tensor>& found_inf) {
+  // Devices are checked manually, `tensor_lr` overloads are not device
+  // checked by codegen.
+  Device param_device = params[0].device();
+  if (grad_scale.has_value()) {
+    TORCH_CHECK(
+        grad_scale->device() == param_device,
+        "grad_scale must be on the same XPU device as the params");
+  }
+  if (found_inf.has_value()) {
+    TORCH_CHECK(
+        found_inf->device() == param_device,
+        "found_inf must be on the same XPU device as the params");
+  }
+  TORCH_CHECK(
+      lr.device() == param_device,
+      "lr must be on the same XPU device as the params");
+}
+
+} // namespace
+
+void XPUNativeFunctions::_fused_sgd_(
+    TensorList self,
+    TensorList grads,
+    TensorList momentum_buffer_list,
+    double weight_decay,
+    double momentum,
+    double lr,
+    double dampening,
+    bool nesterov,
+    bool maximize,
+    bool is_first_step,
+    const c10::optional<Tensor>& grad_scale,
+    const c10::optional<Tensor>& found_inf) {
+  check_fused_sgd_inputs(
+      self, grads, momentum_buffer_list, momentum, is_first_step);
+  native::xpu::fused_sgd_kernel(
+      self,
+      grads,
+      momentum_buffer_list,
+      weight_decay,
+      momentum,
+      lr,
+      Tensor(),
+      dampening,
+      nesterov,
+      maximize,
+      is_first_step,
+      grad_scale,
+      found_inf);
+}
+
+void XPUNativeFunctions::_fused_sgd_(
+    TensorList self,
+    TensorList grads,
+    TensorList momentum_buffer_list,
+    double weight_decay,
+    double momentum,
+    const Tensor& lr,
+    double dampening,
+    bool nesterov,
+    bool maximize,
+    bool is_first_step,
+    const c10::optional<Tensor>& grad_scale,
+    const c10::optional<Tensor>& found_inf) {
+  if (lr.is_cpu()) {
+    return XPUNativeFunctions::_fused_sgd_(
+        self,
+        grads,
+        momentum_buffer_list,
+        weight_decay,
+        momentum,
+        lr.item<double>(),
+        dampening,
+        nesterov,
+        maximize,
+        is_first_step,
+        grad_scale,
+        found_inf);
+  }
+  check_fused_sgd_devices(self, lr, grad_scale, found_inf);
+  check_fused_sgd_inputs(
+      self, grads, momentum_buffer_list, momentum, is_first_step);
+  native::xpu::fused_sgd_kernel(
+      self,
+      grads,
+      momentum_buffer_list,
+      weight_decay,
+      momentum,
+      /* lr */ 1.0,
+      lr.to(kFloat),
+      dampening,
+      nesterov,
+      maximize,
+      is_first_step,
+      grad_scale,
+      found_inf);
+}
+
+} // namespace at
@@ -115,6 +115,34 @@ Tensor& XPUNativeFunctions::cumprod_(
   return XPUNativeFunctions::cumprod_out(self, dim, dtype, self);
 }
 
+void XPUNativeFunctions::_cummax_helper(
+    const Tensor& self,
+    Tensor& values,
+    Tensor& indices,
+    int64_t dim) {
+  native::xpu::cummax_helper_kernel(self, values, indices, dim);
+}
+
+void XPUNativeFunctions::_cummin_helper(
+    const Tensor& self,
+    Tensor& values,
+    Tensor& indices,
+    int64_t dim) {
+  native::xpu::cummin_helper_kernel(self, values, indices, dim);
+}
+
+Tensor& XPUNativeFunctions::_logcumsumexp_out(
+    const Tensor& self,
+    int64_t dim,
+    Tensor& result) {
+  return native::xpu::logcumsumexp_kernel(self, dim, result);
+}
+
+Tensor XPUNativeFunctions::_logcumsumexp(const Tensor& self, int64_t dim) {
+  Tensor result = at::empty_like(self, MemoryFormat::Contiguous);
+  return native::xpu::logcumsumexp_kernel(self, dim, result);
+}
+
 static ScalarType infer_dtype_from_optional(
     const Tensor& self,
     const optional<ScalarType>& opt_dtype,
@@ -558,6 +586,63 @@ static inline void warn_invalid_degrees_of_freedom(
   }
 }
 
+// For complex, the variance is the sum of the variances of the real and
+// imaginary components, and the mean is mean_real + j * mean_imag. The
+// statistics of both components are computed in a single pass over self, mean
+// is skipped if undefined.
+static void std_var_complex_out(
+    const char* fname,
+    Tensor& var,
+    Tensor& mean,
+    const Tensor& self,
+    at::OptionalIntArrayRef dim,
+    const std::optional<Scalar>& correction_opt,
+    bool keepdim,
+    bool take_sqrt) {
+  const auto correction = correction_opt.value_or(1).toDouble();
+  ScalarType dtype =
+      c10::toRealValueType(at::native::get_dtype_from_result(var, {}));
+  ScalarType complex_dtype = c10::toComplexType(dtype);
+  Tensor input =
+      self.scalar_type() == complex_dtype ? self : self.to(complex_dtype);
+
+  // var_real, mean_real, var_imag, mean_imag
+  std::array<Tensor, 4> parts;
+  const int64_t ndim = input.dim();
+  auto mask = at::native::make_dim_mask(dim, ndim);
+  TensorIteratorConfig config;
+  config.set_check_mem_overlap(false)
+      .resize_outputs(false)
+      .is_reduction(true)
+      .check_all_same_dtype(false);
+  for (auto& part : parts) {
+    part = at::empty({0}, input.options().dtype(dtype));
+    at::native::resize_reduction_result(part, input, mask, keepdim, dtype);
+    config.add_owned_output(
+        at::native::review_reduce_result(part, ndim, mask, keepdim));
+  }
+  config.add_owned_const_input(input);
+  auto iter = config.build();
+  warn_invalid_degrees_of_freedom(fname, iter, correction);
+
+  if (iter.numel() == 0) {
+    // Trivial reduction
+    for (auto& part : parts) {
+      part.fill_(std::numeric_limits<double>::quiet_NaN());
+    }
+  } else {
+    native::xpu::std_var_complex_kernel(iter, correction);
+  }
+
+  at::add_out(var, parts[0], parts[2]);
+  if (take_sqrt) {
+    at::sqrt_out(var, var);
+  }
+  if (mean.defined()) {
+    at::complex_out(mean, parts[1], parts[3]);
+  }
+}
+
 static Tensor& std_var_out(
     const char* fname,
     Tensor& result,
@@ -580,36 +665,9 @@ static Tensor& std_var_out(
       "std and var only support floating point and complex dtypes");
 
   if (at::isComplexType(self.scalar_type())) {
-    // For complex, calculate variance of real and imaginary components
-    // separately then add to get overall variance.
-    ScalarType dtype =
-        c10::toRealValueType(at::native::get_dtype_from_result(result, {}));
-    Tensor real_in = at::real(self);
-    Tensor real_out = at::empty({0}, self.options().dtype(dtype));
-    std_var_out(
-        fname,
-        real_out,
-        real_in,
-        dim,
-        correction_opt,
-        keepdim,
-        /*take_sqrt=*/false);
-
-    Tensor imag_in = at::imag(self);
-    Tensor imag_out = at::empty({0}, self.options().dtype(dtype));
-    std_var_out(
-        fname,
-        imag_out,
-        imag_in,
-        dim,
-        correction_opt,
-        keepdim,
-        /*take_sqrt=*/false);
-
-    at::add_out(result, real_out, imag_out);
-    if (take_sqrt) {
-      at::sqrt_out(result, result);
-    }
+    Tensor mean;
+    std_var_complex_out(
+        fname, result, mean, self, dim, correction_opt, keepdim, take_sqrt);
     return result;
   }
 
@@ -672,42 +730,8 @@ static std::tuple<Tensor&, Tensor&> std_var_mean_out(
       ".");
 
   if (at::isComplexType(self.scalar_type())) {
-    // For complex, calculate for real and imaginary components separately then
-    // combine as: variance = var_real + var_imag mean = mean_real + j *
-    // mean_imag
-    ScalarType dtype =
-        c10::toRealValueType(at::native::get_dtype_from_result(result1, {}));
-    Tensor real_in = at::real(self);
-    Tensor real_out_var = at::empty({0}, self.options().dtype(dtype));
-    Tensor real_out_mean = at::empty({0}, self.options().dtype(dtype));
-    std_var_mean_out(
-        fname,
-        real_out_var,
-        real_out_mean,
-        real_in,
-        dim,
-        correction_opt,
-        keepdim,
-        /*take_sqrt=*/false);
-
-    Tensor imag_in = at::imag(self);
-    Tensor imag_out_var = at::empty({0}, self.options().dtype(dtype));
-    Tensor imag_out_mean = at::empty({0}, self.options().dtype(dtype));
-    std_var_mean_out(
-        fname,
-        imag_out_var,
-        imag_out_mean,
-        imag_in,
-        dim,
-        correction_opt,
-        keepdim,
-        /*take_sqrt=*/false);
-
-    at::add_out(result1, real_out_var, imag_out_var);
-    if (take_sqrt) {
-      at::sqrt_out(result1, result1);
-    }
-    at::complex_out(result2, real_out_mean, imag_out_mean);
+    std_var_complex_out(
+        fname, result1, result2, self, dim, correction_opt, keepdim, take_sqrt);
     return std::tuple<Tensor&, Tensor&>(result1, result2);
   }
 
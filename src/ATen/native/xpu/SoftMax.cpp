@@ -4,6 +4,7 @@
 #include <ATen/native/xpu/sycl/SoftMaxKernels.h>
 #include <ATen/xpu/XPUNativeFunctions.h>
 #include <comm/RegisterUtils.h>
+#include <torch/library.h>
 
 namespace at {
 
@@ -211,4 +212,44 @@ Tensor& XPUNativeFunctions::_log_softmax_backward_data_out(
       grad_output, output, dim, false, grad_input);
 }
 
+Tensor XPUNativeFunctions::_masked_softmax(
+    const Tensor& self,
+    const Tensor& mask,
+    const c10::optional<int64_t> dim,
+    const c10::optional<int64_t> mask_type) {
+  return native::xpu::masked_softmax_kernel(self, mask, dim, mask_type);
+}
+
+Tensor XPUNativeFunctions::_masked_softmax_backward(
+    const Tensor& grad_output,
+    const Tensor& output,
+    const Tensor& mask,
+    const c10::optional<int64_t> dim) {
+  return native::xpu::masked_softmax_backward_kernel(
+      grad_output, output, mask, dim);
+}
+
+static Tensor log_softmax_nll_loss(
+    const Tensor& self,
+    const Tensor& target,
+    const c10::optional<Tensor>& weight,
+    int64_t reduction,
+    int64_t ignore_index) {
+  return native::xpu::log_softmax_nll_loss_kernel(
+      self, target, weight.value_or(Tensor()), reduction, ignore_index);
+}
+
+// Fused cross entropy forward on class indices for inference, e.g. the loss
+// of an LM head, without materializing log_softmax of the logits:
+// torch.ops.torch_xpu_ops._log_softmax_nll_loss(logits, target) equals
+// nll_loss(log_softmax(logits, -1), target). It has no autograd formula.
+TORCH_LIBRARY_FRAGMENT(torch_xpu_ops, m) {
+  m.def(
+      "_log_softmax_nll_loss(Tensor self, Tensor target, Tensor? weight=None, int reduction=1, int ignore_index=-100) -> Tensor");
+}
+
+TORCH_LIBRARY_IMPL(torch_xpu_ops, XPU, m) {
+  m.impl("_log_softmax_nll_loss", TORCH_FN(log_softmax_nll_loss));
+}
+
 } // namespace at
@@ -8,10 +8,12 @@
 #include <ATen/native/IndexingUtils.h>
 #include <ATen/native/ReduceOpsUtils.h>
 #include <ATen/native/ReductionType.h>
+#include <ATen/native/Resize.h>
 #include <ATen/native/ScatterGatherChecks.h>
 #include <ATen/native/TensorAdvancedIndexing.h>
 #include <ATen/native/TensorAdvancedIndexingUtils.h>
 #include <ATen/native/TensorIterator.h>
+#include <ATen/native/xpu/sycl/IndexAssert.h>
 #include <ATen/native/xpu/sycl/IndexingKernels.h>
 #include <ATen/native/xpu/sycl/ScatterGatherKernels.h>
 #include <ATen/xpu/XPUNativeFunctions.h>
@@ -315,6 +317,173 @@ Tensor XPUNativeFunctions::index_add(
   return index_add_out(self, dim, index, source, alpha, out);
 }
 
+static void index_copy_meta(
+    Tensor& result,
+    const Tensor& self,
+    int64_t dim,
+    const Tensor& index,
+    const Tensor& source) {
+  if (result.defined()) {
+    at::assert_no_internal_overlap(result);
+    at::assert_no_overlap(result, index);
+    at::assert_no_overlap(result, source);
+  }
+
+  TORCH_CHECK_INDEX(
+      index.dim() < 2,
+      "index_copy_(): Index should have dimension 1 or 0 (got ",
+      index.dim(),
+      ")");
+
+  int64_t numIndices = index.numel();
+  if (source.dim() == 0 && numIndices != 1) {
+    TORCH_CHECK_INDEX(
+        false,
+        "index_copy_(): When source is scalar, index should have one element (got ",
+        numIndices,
+        ")");
+  } else if (
+      (source.dim() != self.dim()) && (source.dim() != 0 && self.dim() != 0)) {
+    TORCH_CHECK_INDEX(
+        false,
+        "index_copy_(): When source and destination are not scalars, their dimensionality must match. Source dimensionality (",
+        source.dim(),
+        "), destination dimensionality (",
+        self.dim(),
+        ")");
+  }
+
+  TORCH_CHECK(
+      index.scalar_type() == ScalarType::Long,
+      "index_copy_(): Expected a long tensor for index, but got ",
+      index.scalar_type());
+  TORCH_CHECK(
+      self.scalar_type() == source.scalar_type(),
+      "index_copy_(): self and source expected to have the same dtype, but got (self) ",
+      self.scalar_type(),
+      " and (source) ",
+      source.scalar_type());
+
+  // Check that source and destination slices have the same size
+  auto selfSlicedSizes = self.sizes().vec();
+  if (!selfSlicedSizes.empty()) {
+    selfSlicedSizes.erase(selfSlicedSizes.begin() + dim);
+  }
+  auto sourceSlicedSizes = source.sizes().vec();
+  if (!sourceSlicedSizes.empty()) {
+    sourceSlicedSizes.erase(sourceSlicedSizes.begin() + dim);
+  }
+  TORCH_CHECK(
+      selfSlicedSizes == sourceSlicedSizes,
+      "index_copy_(): Source/destination tensor must have same slice shapes. Destination slice shape: ",
+      IntArrayRef(selfSlicedSizes),
+      " at dimension ",
+      dim,
+      " and source slice shape: ",
+      IntArrayRef(sourceSlicedSizes),
+      " at dimension 0.");
+
+  TORCH_CHECK_INDEX(
+      source.dim() == 0 || numIndices == source.size(dim),
+      "index_copy_(): Number of indices (",
+      numIndices,
+      ") should be equal to source.size(dim) (",
+      source.size(dim),
+      ")");
+
+  if (result.defined()) {
+    at::xpu::resize_out(result, self.sizes(), {}, self.options());
+  } else {
+    result = at::xpu::create_out(self.sizes(), {}, self.options());
+  }
+}
+
+Tensor& XPUNativeFunctions::index_copy_out(
+    const Tensor& self,
+    int64_t dim,
+    const Tensor& index,
+    const Tensor& source,
+    Tensor& out) {
+  std::optional<Device> common_device = std::nullopt;
+  c10::impl::check_and_update_common_device(
+      common_device, self, "xpu::index_copy_out", "self");
+  c10::impl::check_and_update_common_device(
+      common_device, index, "xpu::index_copy_out", "index");
+  c10::impl::check_and_update_common_device(
+      common_device, source, "xpu::index_copy_out", "source");
+  dim = maybe_wrap_dim(dim, self.dim());
+  index_copy_meta(out, self, dim, index, source);
+  native::xpu::index_copy_kernel(self, dim, index, source, out);
+  return out;
+}
+
+Tensor& XPUNativeFunctions::index_copy_(
+    Tensor& self,
+    int64_t dim,
+    const Tensor& index,
+    const Tensor& source) {
+  return index_copy_out(self, dim, index, source, self);
+}
+
+Tensor XPUNativeFunctions::index_copy(
+    const Tensor& self,
+    int64_t dim,
+    const Tensor& index,
+    const Tensor& source) {
+  Tensor out;
+  return index_copy_out(self, dim, index, source, out);
+}
+
+Tensor& XPUNativeFunctions::index_reduce_out(
+    const Tensor& self,
+    int64_t dim,
+    const Tensor& index,
+    const Tensor& source,
+    c10::string_view reduce,
+    bool include_self,
+    Tensor& out) {
+  std::optional<Device> common_device = std::nullopt;
+  c10::impl::check_and_update_common_device(
+      common_device, self, "xpu::index_reduce_out", "self");
+  c10::impl::check_and_update_common_device(
+      common_device, index, "xpu::index_reduce_out", "index");
+  c10::impl::check_and_update_common_device(
+      common_device, source, "xpu::index_reduce_out", "source");
+  TORCH_CHECK(
+      reduce == "prod" || reduce == "mean" || reduce == "amax" ||
+          reduce == "amin",
+      "index_reduce(): Expected reduce to be one of prod, mean, amax or amin but got ",
+      reduce,
+      ".");
+  dim = maybe_wrap_dim(dim, self.dim());
+  index_func_meta_impl(out, self, dim, index, source, "index_reduce");
+  auto op = get_operator_enum(reduce, /*use_new_options=*/true);
+  native::xpu::index_reduce_kernel(
+      self, dim, index, source, include_self, op, out);
+  return out;
+}
+
+Tensor& XPUNativeFunctions::index_reduce_(
+    Tensor& self,
+    int64_t dim,
+    const Tensor& index,
+    const Tensor& source,
+    c10::string_view reduce,
+    bool include_self) {
+  return index_reduce_out(self, dim, index, source, reduce, include_self, self);
+}
+
+Tensor XPUNativeFunctions::index_reduce(
+    const Tensor& self,
+    int64_t dim,
+    const Tensor& index,
+    const Tensor& source,
+    c10::string_view reduce,
+    bool include_self) {
+  Tensor out;
+  return index_reduce_out(self, dim, index, source, reduce, include_self, out);
+}
+
 Tensor& XPUNativeFunctions::index_fill_(
     Tensor& self,
     int64_t dim,
@@ -511,6 +680,118 @@ static TensorIterator make_index_put_iterator(
   return config.build();
 }
 
+Tensor& XPUNativeFunctions::take_out(
+    const Tensor& self,
+    const Tensor& index,
+    Tensor& out) {
+  TORCH_CHECK(
+      index.scalar_type() == ScalarType::Long,
+      "take(): Expected a long tensor for index, but got ",
+      index.scalar_type())
+  TORCH_CHECK(
+      self.scalar_type() == out.scalar_type(),
+      "take(): self and out expected to have the same dtype, but got self.dtype = ",
+      self.scalar_type(),
+      " and out.dtype = ",
+      out.scalar_type());
+  TORCH_CHECK(
+      self.device() == out.device() && index.device() == out.device(),
+      "take(): self, index and out expected to be in the same device, but got self.device = ",
+      self.device(),
+      ", index.device = ",
+      index.device(),
+      ", and out.device = ",
+      out.device());
+  TORCH_CHECK_INDEX(
+      !(self.numel() == 0 && index.numel() != 0),
+      "take(): tried to take from an empty tensor");
+
+  at::assert_no_internal_overlap(out);
+  at::assert_no_overlap(out, index);
+  at::assert_no_overlap(out, self);
+
+  at::native::resize_output(out, index.sizes());
+  if (index.numel() == 0) {
+    return out;
+  }
+
+  // take is index_select on the flattened self.
+  auto flat_out = out.is_contiguous()
+      ? out.view(-1)
+      : at::empty({index.numel()}, out.options());
+  native::xpu::index_select_kernel(
+      self.reshape(-1), 0, index.reshape(-1), flat_out);
+  if (!out.is_contiguous()) {
+    out.copy_(flat_out.view(index.sizes()));
+  }
+  return out;
+}
+
+Tensor XPUNativeFunctions::take(const Tensor& self, const Tensor& index) {
+  auto out = at::empty(index.sizes(), self.options());
+  return take_out(self, index, out);
+}
+
+Tensor& XPUNativeFunctions::put_(
+    Tensor& self,
+    const Tensor& index,
+    const Tensor& source,
+    const bool accumulate) {
+  // See note [Writing Nondeterministic Operations]
+  // Nondeterministic when index contains duplicate entries and we do not
+  // accumulate. Accumulation takes the sorted index_put path.
+  if (!accumulate) {
+    at::globalContext().alertNotDeterministic("put_");
+  }
+
+  TORCH_CHECK(
+      index.scalar_type() == ScalarType::Long,
+      "put_(): Expected a long tensor for index, but got ",
+      index.scalar_type())
+  TORCH_CHECK(
+      self.scalar_type() == source.scalar_type(),
+      "put_(): self and source expected to have the same dtype, but got self.dtype = ",
+      self.scalar_type(),
+      " and source.dtype = ",
+      source.scalar_type());
+  TORCH_CHECK(
+      self.device() == source.device() && self.device() == index.device(),
+      "put_(): self, index and source expected to be in the same device, but got self.device = ",
+      self.device(),
+      ", index.device = ",
+      index.device(),
+      ", and source.device = ",
+      source.device());
+  TORCH_CHECK_INDEX(
+      source.numel() == index.numel(),
+      "put_(): Expected source and index to have the same number of elements, but got source.numel() = ",
+      source.numel(),
+      ", index.numel() = ",
+      index.numel());
+  TORCH_CHECK_INDEX(
+      !(self.numel() == 0 && index.numel() != 0),
+      "put_(): Tried to put elements into an empty tensor");
+
+  at::assert_no_internal_overlap(self);
+  at::assert_no_overlap(self, index);
+  at::assert_no_overlap(self, source);
+
+  if (index.numel() == 0) {
+    return self;
+  }
+
+  // put_ is index_put_ on the flattened self.
+  auto flat_self = self.contiguous().view(-1);
+  torch::List<c10::optional<Tensor>> indices;
+  indices.push_back(index.reshape(-1));
+  _index_put_impl_(
+      flat_self, indices, source.reshape(-1), accumulate, /*unsafe=*/false);
+  if (!self.is_contiguous()) {
+    self.copy_(flat_self.view(self.sizes()));
+  }
+  return self;
+}
+
 Tensor& XPUNativeFunctions::_index_put_impl_(
     Tensor& self,
     const torch::List<c10::optional<Tensor>>& indices,
@@ -699,6 +980,30 @@ static void _scatter_via_index_put(
   }
 }
 
+// Half and BFloat16 atomics are compare-exchange loops, which serialize when
+// many updates hit the same element. Once there are many updates per
+// destination along dim, sorting the updates by destination, reducing each
+// segment and writing it once (the deterministic index_put path) is faster.
+// How skewed the indices are is not known without a host sync, so the number
+// of updates per destination bounds the collisions instead.
+constexpr int64_t kScatterSortMinUpdatesPerElement = 16;
+
+static bool scatter_prefers_sort(
+    const Tensor& self,
+    int64_t dim,
+    const Tensor& index) {
+  if (globalContext().deterministicAlgorithms()) {
+    return true;
+  }
+  if (self.scalar_type() != kHalf && self.scalar_type() != kBFloat16) {
+    return false;
+  }
+  if (self.dim() == 0 || self.size(dim) == 0) {
+    return false;
+  }
+  return index.size(dim) >= kScatterSortMinUpdatesPerElement * self.size(dim);
+}
+
 template <
     bool use_new_options = false,
     typename T,
@@ -725,8 +1030,9 @@ void scatter_impl(
     return;
 
   auto op = ReductionType::SUM;
-  bool deterministic = globalContext().deterministicAlgorithms() &&
-      self.device().type() == DeviceType::XPU;
+  bool deterministic = self.device().type() == DeviceType::XPU &&
+      (globalContext().deterministicAlgorithms() ||
+       (reduce.has_value() && scatter_prefers_sort(self, dim, index)));
 
   if (reduce.has_value()) {
     op = get_operator_enum(reduce.value(), use_new_options);
@@ -1169,9 +1475,10 @@ Tensor& scatter_add_impl(
     return out;
 
   // See Note [Enabling Deterministic Operations]
-  // Avoid gpuAtomicAdd for XPU if deterministic mode is turned on
-  if (globalContext().deterministicAlgorithms() &&
-      self.device().type() == DeviceType::XPU) {
+  // Avoid gpuAtomicAdd for XPU if deterministic mode is turned on, or if the
+  // updates collide heavily
+  if (self.device().type() == DeviceType::XPU &&
+      scatter_prefers_sort(self, dim, index)) {
     _scatter_via_index_put(self, dim, index, src, mut_out, /*accumulate*/ true);
   } else {
     // TODO: enable fast paths for GNN usage (scatter_add_expanded_index_kernel)
@@ -1447,4 +1754,14 @@ Tensor XPUNativeFunctions::count_nonzero(const Tensor& self, IntArrayRef dims) {
   return (self != 0).sum(dims);
 }
 
+static void xpu_check_index_errors() {
+  native::xpu::check_index_errors();
+}
+
+// Raises an out of bounds index found by an XPU kernel on the current
+// stream, e.g. once per training step. See IndexAssert.h.
+TORCH_LIBRARY_FRAGMENT(torch_xpu_ops, m) {
+  m.def("_check_index_errors() -> ()", TORCH_FN(xpu_check_index_errors));
+}
+
 } // namespace at
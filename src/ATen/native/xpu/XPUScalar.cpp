@@ -4,6 +4,7 @@
 #include <ATen/core/Tensor.h>
 #include <ATen/xpu/XPUNativeFunctions.h>
 
+#include <ATen/native/xpu/sycl/IndexAssert.h>
 #include <comm/SYCLContext.h>
 
 namespace at {
@@ -38,6 +39,7 @@ Scalar XPUNativeFunctions::_local_scalar_dense(const Tensor& self) {
       kBool,
       kBFloat16,
       AT_EXPAND(AT_BAREBONES_UNSIGNED_TYPES));
+  native::xpu::check_index_errors_after_sync();
   return r;
 }
 
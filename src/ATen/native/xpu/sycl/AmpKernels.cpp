@@ -48,7 +48,7 @@ void amp_non_finite_check_and_unscale_kernel(
 
         AmpNonFiniteCheckUnscaleFunctor<scalar_t> f(
             found_inf_ptr, inv_scale_ptr);
-        gpu_kernel(iter, f);
+        gpu_kernel(iter, f, /*persistent=*/true);
       });
 }
 
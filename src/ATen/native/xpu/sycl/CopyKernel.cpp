@@ -18,15 +18,20 @@ struct CopyScalarFunc {
 
 void copy_kernel(TensorIterator& iter) {
   ScalarType dtype = iter.common_dtype();
+  // Copies and dtype casts are pure bandwidth, launch them persistently to
+  // save group dispatch on large tensors.
+  constexpr bool persistent = true;
   if (isQIntType(dtype)) {
     AT_DISPATCH_QINT_TYPES(dtype, "copy_xpu", [&] {
-      gpu_kernel(iter, CopyScalarFunc<scalar_t>());
+      gpu_kernel(iter, CopyScalarFunc<scalar_t>(), persistent);
     });
   } else {
     AT_DISPATCH_V2(
         dtype,
         "copy_xpu",
-        AT_WRAP([&] { gpu_kernel(iter, CopyScalarFunc<scalar_t>()); }),
+        AT_WRAP([&] {
+          gpu_kernel(iter, CopyScalarFunc<scalar_t>(), persistent);
+        }),
         AT_EXPAND(AT_ALL_TYPES_AND_COMPLEX),
         kHalf,
         kBool,
@@ -0,0 +1,88 @@
+#include <ATen/Dispatch.h>
+#include <ATen/NumericUtils.h>
+#include <ATen/core/Tensor.h>
+
+#include <ATen/native/xpu/sycl/NumericLimits.h>
+#include <ATen/native/xpu/sycl/ScanUtils.h>
+
+namespace at::native::xpu {
+
+// Picks the extremum of two (value, index) pairs under a total order, so
+// that the combine is associative and commutative as the scan requires. NaN
+// is the extremum, and among NaNs as among equal values the latest index
+// wins. This matches the sequential CPU and CUDA kernels, which move the
+// running index to every NaN they meet.
+template <typename scalar_t, bool is_max>
+struct CumMinMaxFunctor {
+  ScanPair<scalar_t> operator()(ScanPair<scalar_t> a, ScanPair<scalar_t> b)
+      const {
+    bool a_nan = at::_isnan(a.value);
+    bool b_nan = at::_isnan(b.value);
+    if (a_nan || b_nan) {
+      if (a_nan && b_nan) {
+        return a.index > b.index ? a : b;
+      }
+      return a_nan ? a : b;
+    }
+    if (a.value == b.value) {
+      return a.index > b.index ? a : b;
+    }
+    if constexpr (is_max) {
+      return a.value > b.value ? a : b;
+    } else {
+      return a.value < b.value ? a : b;
+    }
+  }
+};
+
+void launch_cummax_kernel(
+    const Tensor& self,
+    const Tensor& values,
+    const Tensor& indices,
+    int64_t dim) {
+  AT_DISPATCH_ALL_TYPES_AND3(
+      ScalarType::Bool,
+      ScalarType::Half,
+      ScalarType::BFloat16,
+      self.scalar_type(),
+      "cummax_xpu",
+      [&]() {
+        // The index of the identity is below any position, so that it loses
+        // ties against elements equal to the lower bound.
+        ScanPair<scalar_t> init = {
+            at::numeric_limits<scalar_t>::lower_bound(), -1};
+        scan_with_indices<INCLUSIVE_TYPE, scalar_t>(
+            values,
+            indices,
+            self,
+            dim,
+            init,
+            CumMinMaxFunctor<scalar_t, true>());
+      });
+}
+
+void launch_cummin_kernel(
+    const Tensor& self,
+    const Tensor& values,
+    const Tensor& indices,
+    int64_t dim) {
+  AT_DISPATCH_ALL_TYPES_AND3(
+      ScalarType::Bool,
+      ScalarType::Half,
+      ScalarType::BFloat16,
+      self.scalar_type(),
+      "cummin_xpu",
+      [&]() {
+        ScanPair<scalar_t> init = {
+            at::numeric_limits<scalar_t>::upper_bound(), -1};
+        scan_with_indices<INCLUSIVE_TYPE, scalar_t>(
+            values,
+            indices,
+            self,
+            dim,
+            init,
+            CumMinMaxFunctor<scalar_t, false>());
+      });
+}
+
+} // namespace at::native::xpu
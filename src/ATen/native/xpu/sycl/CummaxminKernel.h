@@ -0,0 +1,19 @@
+#pragma once
+
+#include <ATen/core/TensorBase.h>
+
+namespace at::native::xpu {
+
+void launch_cummax_kernel(
+    const Tensor& self,
+    const Tensor& values,
+    const Tensor& indices,
+    int64_t dim);
+
+void launch_cummin_kernel(
+    const Tensor& self,
+    const Tensor& values,
+    const Tensor& indices,
+    int64_t dim);
+
+} // namespace at::native::xpu
@@ -57,7 +57,8 @@ Tensor embedding_dense_backward_kernel(
                     sorted_begin,
                     orig_begin,
                     num_indices,
-                    false);
+                    false,
+                    num_weights);
               }
 
               if (scale_grad_by_freq) {
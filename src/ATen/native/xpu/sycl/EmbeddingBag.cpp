@@ -2,8 +2,10 @@
 #include <ATen/AccumulateType.h>
 #include <ATen/Dispatch.h>
 
+#include <ATen/native/xpu/sycl/EmbeddingBackwardKernel.h>
 #include <ATen/native/xpu/sycl/EmbeddingBag.h>
 #include <ATen/native/xpu/sycl/MemoryAccess.h>
+#include <ATen/native/xpu/sycl/pstl/PSTLFunctions.h>
 
 namespace at::native::xpu {
 
@@ -440,4 +442,293 @@ std::tuple<Tensor, Tensor, Tensor, Tensor> _embedding_bag_kernel(
       output, offset2bag, bag_size, max_indices);
 }
 
+template <typename index_t>
+struct EmbeddingBagBackwardEqFunctor {
+  auto operator()(index_t a, index_t b) const {
+    return a == b;
+  }
+};
+
+// Sum and mean gradients of the rows: samples are sorted by row, and each
+// segment of equal rows is reduced and written once, scaled by the bag size
+// in mean mode and by the per-sample weights, skipping padding_idx.
+static Tensor embedding_bag_backward_xpu_sum_avg(
+    const Tensor& grad,
+    const Tensor& indices_,
+    const Tensor& offset2bag,
+    const Tensor& bag_size,
+    int64_t num_weights,
+    bool scale_grad_by_freq,
+    int64_t mode,
+    const Tensor& per_sample_weights,
+    int64_t padding_idx) {
+  auto indices = indices_.contiguous();
+  ptrdiff_t num_indices = indices.numel();
+  if (num_indices == 0) {
+    return at::zeros({num_weights, grad.size(1)}, grad.options());
+  }
+
+  auto sorted_indices =
+      at::empty_like(indices, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  auto orig_indices = at::empty_like(indices, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  Tensor count;
+  Tensor grad_weight;
+
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      at::ScalarType::Half,
+      at::ScalarType::BFloat16,
+      grad.scalar_type(),
+      "embedding_bag_backward_xpu_sum_avg",
+      [&]() {
+        AT_DISPATCH_INDEX_TYPES(
+            indices.scalar_type(), "embedding_bag_backward_xpu_sum_avg", [&] {
+              index_t* sorted_begin = sorted_indices.data_ptr<index_t>();
+              index_t* orig_begin = orig_indices.data_ptr<index_t>();
+              {
+                sorted_indices.copy_(indices);
+                pstl::itoa(orig_begin, orig_begin + num_indices, (index_t)0);
+                pstl::sort<index_t, index_t>(
+                    indices.data_ptr<index_t>(),
+                    sorted_begin,
+                    orig_begin,
+                    num_indices,
+                    false,
+                    num_weights);
+              }
+
+              if (scale_grad_by_freq) {
+                count = at::empty_like(sorted_indices);
+                index_t* count_begin = count.data_ptr<index_t>();
+                EmbeddingBagBackwardEqFunctor<index_t> f;
+                pstl::count_by_segment<index_t, index_t, index_t>(
+                    sorted_begin, sorted_begin + num_indices, count_begin, f);
+              }
+              grad_weight =
+                  embedding_backward_deterministic_kernel<scalar_t, index_t>(
+                      grad,
+                      orig_indices,
+                      sorted_indices,
+                      count,
+                      num_weights,
+                      padding_idx,
+                      mode == MODE_MEAN,
+                      offset2bag,
+                      bag_size,
+                      per_sample_weights);
+            });
+      });
+  return grad_weight;
+}
+
+// Max gradients: each feature of a bag takes the gradient of its own max
+// row, so element (bag, f) goes to element (max_indices[bag][f], f) of the
+// weight. The elements are scattered by index_put_ with accumulation, which
+// sorts them and writes each weight element once. Empty bags, whose max
+// index is -1, and padding_idx go to a spare row that is dropped.
+static Tensor embedding_bag_backward_xpu_max(
+    const Tensor& grad,
+    const Tensor& max_indices,
+    int64_t num_weights,
+    int64_t padding_idx) {
+  int64_t features = grad.size(1);
+  auto grad_weight = at::zeros({num_weights + 1, features}, grad.options());
+  if (grad.numel() == 0) {
+    return grad_weight.narrow(0, 0, num_weights);
+  }
+
+  auto rows = max_indices.to(kLong);
+  rows = at::where(
+      (rows < 0).logical_or_(rows == padding_idx), num_weights, rows);
+  auto linear_indices = rows * features + at::arange(features, rows.options());
+
+  torch::List<c10::optional<Tensor>> indices;
+  indices.push_back(linear_indices.view(-1));
+  grad_weight.view(-1).index_put_(indices, grad.reshape(-1), true);
+  return grad_weight.narrow(0, 0, num_weights);
+}
+
+Tensor _embedding_bag_dense_backward_kernel(
+    const Tensor& grad_,
+    const Tensor& indices,
+    const Tensor& offset2bag,
+    const Tensor& bag_size,
+    const Tensor& max_indices,
+    int64_t num_weights,
+    bool scale_grad_by_freq,
+    int64_t mode,
+    const Tensor& per_sample_weights,
+    int64_t padding_idx) {
+  // indices, offsets and offset2bag are assumed having correct dtypes and
+  // contiguous here due to the checks in _embedding_bag_backward.
+  Tensor grad = grad_.contiguous();
+  auto indices_arg = TensorArg(indices, "indices", 1);
+  auto grad_arg = TensorArg(grad, "grad", 1);
+  checkSameGPU("embedding_bag_xpu", grad_arg, indices_arg);
+
+  switch (mode) {
+    case MODE_SUM:
+    case MODE_MEAN:
+      if (mode == MODE_MEAN) {
+        TORCH_INTERNAL_ASSERT(!per_sample_weights.defined());
+      }
+      return embedding_bag_backward_xpu_sum_avg(
+          grad,
+          indices,
+          offset2bag,
+          bag_size,
+          num_weights,
+          scale_grad_by_freq,
+          mode,
+          per_sample_weights,
+          padding_idx);
+    case MODE_MAX:
+      TORCH_INTERNAL_ASSERT(!per_sample_weights.defined());
+      return embedding_bag_backward_xpu_max(
+          grad, max_indices, num_weights, padding_idx);
+    default:
+      TORCH_CHECK(0, "Unknown mode for embedding_bag_backward_xpu ", mode);
+  }
+}
+
+template <typename scalar_t, typename index_t>
+struct EmbeddingBagPerSampleWeightsBackwardKernelFunctor {
+  void operator()(sycl::nd_item<1> item) const {
+    using accscalar_t = acc_type_device<scalar_t, kXPU>;
+    auto sg = item.get_sub_group();
+    // A sub-group per sample.
+    int64_t sample = item.get_group(0) * sg.get_group_range()[0] +
+        sg.get_group_id()[0];
+    if (sample >= num_samples_) {
+      return;
+    }
+    int64_t lane = sg.get_local_id()[0];
+    int64_t sg_size = sg.get_local_range()[0];
+
+    const index_t bag = offset2bag_[sample];
+    const index_t embedding_idx = indices_[sample];
+    accscalar_t result = 0;
+    if (embedding_idx != padding_idx_) {
+      const scalar_t* grad_row = grad_ + bag * grad_stride0_;
+      const scalar_t* weight_row = weight_ + embedding_idx * weight_stride0_;
+      for (int64_t f = lane; f < features_; f += sg_size) {
+        result += static_cast<accscalar_t>(grad_row[f * grad_stride1_]) *
+            static_cast<accscalar_t>(weight_row[f * weight_stride1_]);
+      }
+    }
+    result = sycl::reduce_over_group(sg, result, sycl::plus<accscalar_t>());
+    if (lane == 0) {
+      output_[sample] = result;
+    }
+  }
+
+  EmbeddingBagPerSampleWeightsBackwardKernelFunctor(
+      const scalar_t* grad,
+      int64_t grad_stride0,
+      int64_t grad_stride1,
+      const scalar_t* weight,
+      int64_t weight_stride0,
+      int64_t weight_stride1,
+      const index_t* indices,
+      const index_t* offset2bag,
+      int64_t num_samples,
+      int64_t features,
+      scalar_t* output,
+      index_t padding_idx)
+      : grad_(grad),
+        grad_stride0_(grad_stride0),
+        grad_stride1_(grad_stride1),
+        weight_(weight),
+        weight_stride0_(weight_stride0),
+        weight_stride1_(weight_stride1),
+        indices_(indices),
+        offset2bag_(offset2bag),
+        num_samples_(num_samples),
+        features_(features),
+        output_(output),
+        padding_idx_(padding_idx) {}
+
+ private:
+  const scalar_t* grad_;
+  int64_t grad_stride0_;
+  int64_t grad_stride1_;
+  const scalar_t* weight_;
+  int64_t weight_stride0_;
+  int64_t weight_stride1_;
+  const index_t* indices_;
+  const index_t* offset2bag_;
+  int64_t num_samples_;
+  int64_t features_;
+  scalar_t* output_;
+  index_t padding_idx_;
+};
+
+Tensor _embedding_bag_per_sample_weights_backward_kernel(
+    const Tensor& grad,
+    const Tensor& weight, // NB: embedding table, not per_sample_weights
+    const Tensor& indices_,
+    const Tensor& offsets_,
+    const Tensor& offset2bag,
+    int64_t mode,
+    int64_t padding_idx) {
+  TORCH_CHECK(
+      mode == MODE_SUM,
+      "embedding_bag_backward: per_sample_weights only supported for mode='sum'");
+
+  TORCH_INTERNAL_ASSERT(grad.dim() == 2);
+  auto embedding_features = grad.size(1);
+
+  Tensor indices, offsets;
+  std::tie(indices, offsets) = promoteIndicesAndOffsets(indices_, offsets_);
+  TORCH_INTERNAL_ASSERT(indices.dim() == 1);
+  auto num_samples = indices.size(0);
+
+  TORCH_INTERNAL_ASSERT(weight.dim() == 2);
+  TORCH_INTERNAL_ASSERT(weight.size(1) == embedding_features);
+
+  auto output = at::empty({num_samples}, grad.options());
+  if (num_samples == 0) {
+    return output;
+  }
+
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      at::ScalarType::Half,
+      at::ScalarType::BFloat16,
+      grad.scalar_type(),
+      "_embedding_bag_per_sample_weights_backward_xpu",
+      [&]() {
+        AT_DISPATCH_INDEX_TYPES(
+            indices.scalar_type(),
+            "_embedding_bag_per_sample_weights_backward_xpu",
+            [&]() {
+              using KernelClass =
+                  EmbeddingBagPerSampleWeightsBackwardKernelFunctor<
+                      scalar_t,
+                      index_t>;
+              auto offset2bag_ = offset2bag.to(indices.scalar_type());
+              KernelClass kfn(
+                  grad.const_data_ptr<scalar_t>(),
+                  grad.stride(0),
+                  grad.stride(1),
+                  weight.const_data_ptr<scalar_t>(),
+                  weight.stride(0),
+                  weight.stride(1),
+                  indices.const_data_ptr<index_t>(),
+                  offset2bag_.const_data_ptr<index_t>(),
+                  num_samples,
+                  embedding_features,
+                  output.mutable_data_ptr<scalar_t>(),
+                  padding_idx);
+
+              // Enough work-items for a sub-group per sample, whatever
+              // sub-group size the kernel is compiled with.
+              int64_t wg_size = syclMaxWorkGroupSize(kfn);
+              int64_t samples_per_group = wg_size / syclMaxSubGroupSize();
+              int64_t num_groups = CeilDiv(num_samples, samples_per_group);
+              sycl_kernel_submit(
+                  num_groups * wg_size, wg_size, getCurrentSYCLQueue(), kfn);
+            });
+      });
+  return output;
+}
+
 } // namespace at::native::xpu
@@ -0,0 +1,214 @@
+#include <ATen/Dispatch.h>
+#include <ATen/OpMathType.h>
+
+#include <ATen/native/xpu/sycl/FusedAdamKernels.h>
+#include <ATen/native/xpu/sycl/FusedAdamUtils.h>
+#include <ATen/native/xpu/sycl/MultiTensorApply.h>
+
+namespace at::native::xpu {
+
+template <
+    typename scalar_t,
+    typename grad_t,
+    int depth,
+    ADAM_MODE adam_mode,
+    bool amsgrad>
+void fused_adam_template(
+    std::vector<std::vector<Tensor>>& tensor_lists,
+    TensorList state_steps,
+    const float* lr_ptr,
+    const double lr,
+    const double beta1,
+    const double beta2,
+    const double weight_decay,
+    const double eps,
+    const bool maximize,
+    const float* grad_scale_ptr,
+    const float* found_inf_ptr) {
+  multi_tensor_apply_for_fused_optimizer<depth>(
+      tensor_lists,
+      state_steps,
+      FusedAdamMathFunctor<scalar_t, grad_t, depth, adam_mode, amsgrad>(),
+      lr_ptr,
+      lr,
+      beta1,
+      beta2,
+      weight_decay,
+      eps,
+      maximize,
+      grad_scale_ptr,
+      found_inf_ptr);
+}
+
+template <typename scalar_t, typename grad_t, ADAM_MODE adam_mode>
+void fused_adam_dispatch_amsgrad(
+    std::vector<std::vector<Tensor>>& tensor_lists,
+    TensorList state_steps,
+    const float* lr_ptr,
+    const double lr,
+    const double beta1,
+    const double beta2,
+    const double weight_decay,
+    const double eps,
+    const bool amsgrad,
+    const bool maximize,
+    const float* grad_scale_ptr,
+    const float* found_inf_ptr) {
+  if (amsgrad) {
+    fused_adam_template<scalar_t, grad_t, 5, adam_mode, true>(
+        tensor_lists,
+        state_steps,
+        lr_ptr,
+        lr,
+        beta1,
+        beta2,
+        weight_decay,
+        eps,
+        maximize,
+        grad_scale_ptr,
+        found_inf_ptr);
+  } else {
+    fused_adam_template<scalar_t, grad_t, 4, adam_mode, false>(
+        tensor_lists,
+        state_steps,
+        lr_ptr,
+        lr,
+        beta1,
+        beta2,
+        weight_decay,
+        eps,
+        maximize,
+        grad_scale_ptr,
+        found_inf_ptr);
+  }
+}
+
+template <typename scalar_t, typename grad_t>
+void fused_adam_dispatch_mode(
+    std::vector<std::vector<Tensor>>& tensor_lists,
+    TensorList state_steps,
+    const float* lr_ptr,
+    const double lr,
+    const double beta1,
+    const double beta2,
+    const double weight_decay,
+    const double eps,
+    const bool amsgrad,
+    const bool maximize,
+    const float* grad_scale_ptr,
+    const float* found_inf_ptr,
+    const ADAM_MODE adam_mode) {
+  if (adam_mode == ADAM_MODE::ORIGINAL) {
+    fused_adam_dispatch_amsgrad<scalar_t, grad_t, ADAM_MODE::ORIGINAL>(
+        tensor_lists,
+        state_steps,
+        lr_ptr,
+        lr,
+        beta1,
+        beta2,
+        weight_decay,
+        eps,
+        amsgrad,
+        maximize,
+        grad_scale_ptr,
+        found_inf_ptr);
+  } else {
+    fused_adam_dispatch_amsgrad<scalar_t, grad_t, ADAM_MODE::ADAMW>(
+        tensor_lists,
+        state_steps,
+        lr_ptr,
+        lr,
+        beta1,
+        beta2,
+        weight_decay,
+        eps,
+        amsgrad,
+        maximize,
+        grad_scale_ptr,
+        found_inf_ptr);
+  }
+}
+
+void fused_adam_kernel(
+    TensorList params,
+    TensorList grads,
+    TensorList exp_avgs,
+    TensorList exp_avg_sqs,
+    TensorList max_exp_avg_sqs,
+    TensorList state_steps,
+    const double lr,
+    const Tensor& lr_tensor,
+    const double beta1,
+    const double beta2,
+    const double weight_decay,
+    const double eps,
+    const bool amsgrad,
+    const bool maximize,
+    const c10::optional<Tensor>& grad_scale,
+    const c10::optional<Tensor>& found_inf,
+    const ADAM_MODE adam_mode) {
+  std::vector<std::vector<Tensor>> tensor_lists{
+      params.vec(), grads.vec(), exp_avgs.vec(), exp_avg_sqs.vec()};
+  if (amsgrad) {
+    tensor_lists.emplace_back(max_exp_avg_sqs.vec());
+  }
+
+  const float* lr_ptr =
+      lr_tensor.defined() ? lr_tensor.const_data_ptr<float>() : nullptr;
+  const float* grad_scale_ptr =
+      grad_scale.has_value() ? grad_scale->const_data_ptr<float>() : nullptr;
+  const float* found_inf_ptr =
+      found_inf.has_value() ? found_inf->const_data_ptr<float>() : nullptr;
+
+  const auto param_dtype = params[0].scalar_type();
+  const auto grad_dtype = grads[0].scalar_type();
+
+  if (grad_dtype == param_dtype) {
+    AT_DISPATCH_FLOATING_TYPES_AND2(
+        kHalf, kBFloat16, param_dtype, "fused_adam_kernel_xpu", [&]() {
+          fused_adam_dispatch_mode<scalar_t, scalar_t>(
+              tensor_lists,
+              state_steps,
+              lr_ptr,
+              lr,
+              beta1,
+              beta2,
+              weight_decay,
+              eps,
+              amsgrad,
+              maximize,
+              grad_scale_ptr,
+              found_inf_ptr,
+              adam_mode);
+        });
+  } else {
+    // fp32 master params with reduced precision grads.
+    TORCH_CHECK(
+        param_dtype == kFloat &&
+            (grad_dtype == kHalf || grad_dtype == kBFloat16),
+        "fused_adam: grads must have the dtype of params, or be Half/BFloat16 "
+        "for Float params, but got params of ",
+        param_dtype,
+        " and grads of ",
+        grad_dtype);
+    AT_DISPATCH_REDUCED_FLOATING_TYPES(
+        grad_dtype, "fused_adam_kernel_xpu", [&]() {
+          fused_adam_dispatch_mode<float, scalar_t>(
+              tensor_lists,
+              state_steps,
+              lr_ptr,
+              lr,
+              beta1,
+              beta2,
+              weight_decay,
+              eps,
+              amsgrad,
+              maximize,
+              grad_scale_ptr,
+              found_inf_ptr,
+              adam_mode);
+        });
+  }
+}
+
+} // namespace at::native::xpu
@@ -0,0 +1,28 @@
+#pragma once
+#include <ATen/ATen.h>
+
+#include <ATen/native/xpu/sycl/FusedAdamUtils.h>
+
+namespace at::native::xpu {
+
+// `lr` is read from `lr_tensor` on device when it is defined.
+void fused_adam_kernel(
+    TensorList params,
+    TensorList grads,
+    TensorList exp_avgs,
+    TensorList exp_avg_sqs,
+    TensorList max_exp_avg_sqs,
+    TensorList state_steps,
+    const double lr,
+    const Tensor& lr_tensor,
+    const double beta1,
+    const double beta2,
+    const double weight_decay,
+    const double eps,
+    const bool amsgrad,
+    const bool maximize,
+    const c10::optional<Tensor>& grad_scale,
+    const c10::optional<Tensor>& found_inf,
+    const ADAM_MODE adam_mode);
+
+} // namespace at::native::xpu
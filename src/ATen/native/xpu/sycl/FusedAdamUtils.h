@@ -0,0 +1,131 @@
+#pragma once
+#include <ATen/OpMathType.h>
+#include <c10/util/Exception.h>
+
+#include <ATen/native/xpu/sycl/MultiTensorApply.h>
+
+namespace at::native::xpu {
+
+enum class ADAM_MODE : uint8_t { ORIGINAL = 0, ADAMW = 1 };
+
+// Tensor list layout: params, grads, exp_avgs, exp_avg_sqs and, with amsgrad,
+// max_exp_avg_sqs. Grads may be of a lower precision than params, e.g. fp32
+// master params updated from bf16/fp16 grads. Optimizer states always have
+// the dtype of params. Math is done in the opmath type of params.
+template <
+    typename scalar_t,
+    typename grad_t,
+    int depth,
+    ADAM_MODE adam_mode,
+    bool amsgrad>
+struct FusedAdamMathFunctor {
+  static_assert(
+      depth == 4 || depth == 5,
+      "depth of 4 for Adam, depth of 5 for Adam with AMSGrad.");
+  using opmath_t = at::opmath_type<scalar_t>;
+
+  template <typename TLA, typename TLW>
+  void operator()(
+      const int64_t chunk_size,
+      TLA tlAddress,
+      TLW tlWGMeta,
+      sycl::nd_item<1> item_id,
+      const float* lr_ptr,
+      const double lr,
+      const double beta1,
+      const double beta2,
+      const double weight_decay,
+      const double eps,
+      const bool maximize,
+      const float* grad_scale_ptr,
+      const float* found_inf_ptr) const {
+    if (found_inf_ptr && *found_inf_ptr == 1) {
+      return;
+    }
+    auto item_idx = item_id.get_local_id(0);
+    auto item_range = item_id.get_local_range(0);
+    auto group_idx = item_id.get_group(0);
+    int tensor_loc = tlWGMeta[group_idx].wg_to_tensor;
+    int chunk_idx = tlWGMeta[group_idx].wg_to_chunk;
+    int64_t n = tlAddress[tensor_loc].numel_to_tensor;
+    n -= chunk_idx * chunk_size;
+
+    const float step_count =
+        *(float*)tlAddress[tensor_loc].state_steps_addresses;
+    const opmath_t bias_correction1 =
+        1 - std::pow(static_cast<opmath_t>(beta1), step_count);
+    const opmath_t bias_correction2_sqrt = std::sqrt(
+        1 - std::pow(static_cast<opmath_t>(beta2), step_count));
+    const opmath_t lr_val = lr_ptr ? *lr_ptr : static_cast<opmath_t>(lr);
+    const opmath_t step_size = lr_val / bias_correction1;
+
+    scalar_t* param =
+        (scalar_t*)tlAddress[tensor_loc].addresses[0] + chunk_idx * chunk_size;
+    grad_t* grad =
+        (grad_t*)tlAddress[tensor_loc].addresses[1] + chunk_idx * chunk_size;
+    scalar_t* exp_avg =
+        (scalar_t*)tlAddress[tensor_loc].addresses[2] + chunk_idx * chunk_size;
+    scalar_t* exp_avg_sq =
+        (scalar_t*)tlAddress[tensor_loc].addresses[3] + chunk_idx * chunk_size;
+    scalar_t* max_exp_avg_sq = nullptr;
+    if constexpr (amsgrad) {
+      max_exp_avg_sq = (scalar_t*)tlAddress[tensor_loc].addresses[4] +
+          chunk_idx * chunk_size;
+    }
+
+    for (int64_t i_start = 0; i_start < n && i_start < chunk_size;
+         i_start += item_range * kILP) {
+#pragma unroll
+      for (int ii = 0; ii < kILP; ++ii) {
+        int64_t i = i_start + item_idx + ii * item_range;
+        if (i >= n || i >= chunk_size) {
+          continue;
+        }
+        opmath_t p = static_cast<opmath_t>(param[i]);
+        opmath_t g = static_cast<opmath_t>(grad[i]);
+        opmath_t m = static_cast<opmath_t>(exp_avg[i]);
+        opmath_t v = static_cast<opmath_t>(exp_avg_sq[i]);
+
+        if (grad_scale_ptr) {
+          g /= static_cast<opmath_t>(*grad_scale_ptr);
+          // Unscaled grads are written back, matching the unfused path.
+          grad[i] = static_cast<grad_t>(g);
+        }
+        if (maximize) {
+          g = -g;
+        }
+        if (weight_decay != 0) {
+          if constexpr (adam_mode == ADAM_MODE::ORIGINAL) {
+            g += p * static_cast<opmath_t>(weight_decay);
+          } else {
+            p -= lr_val * static_cast<opmath_t>(weight_decay) * p;
+          }
+        }
+
+        m = static_cast<opmath_t>(beta1) * m +
+            (1 - static_cast<opmath_t>(beta1)) * g;
+        v = static_cast<opmath_t>(beta2) * v +
+            (1 - static_cast<opmath_t>(beta2)) * g * g;
+
+        opmath_t denom;
+        if constexpr (amsgrad) {
+          opmath_t max_v = static_cast<opmath_t>(max_exp_avg_sq[i]);
+          max_v = std::max(max_v, v);
+          max_exp_avg_sq[i] = static_cast<scalar_t>(max_v);
+          denom = (std::sqrt(max_v) / bias_correction2_sqrt) +
+              static_cast<opmath_t>(eps);
+        } else {
+          denom = (std::sqrt(v) / bias_correction2_sqrt) +
+              static_cast<opmath_t>(eps);
+        }
+        p -= step_size * m / denom;
+
+        param[i] = static_cast<scalar_t>(p);
+        exp_avg[i] = static_cast<scalar_t>(m);
+        exp_avg_sq[i] = static_cast<scalar_t>(v);
+      }
+    }
+  }
+};
+
+} // namespace at::native::xpu
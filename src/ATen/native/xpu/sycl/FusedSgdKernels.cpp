@@ -0,0 +1,183 @@
+#include <ATen/Dispatch.h>
+#include <ATen/OpMathType.h>
+
+#include <ATen/native/xpu/sycl/FusedSgdKernels.h>
+#include <ATen/native/xpu/sycl/MultiTensorApply.h>
+
+namespace at::native::xpu {
+
+// Tensor list layout: params, grads and, with momentum, momentum buffers.
+template <typename scalar_t, int depth>
+struct FusedSgdMathFunctor {
+  static_assert(
+      depth == 2 || depth == 3,
+      "depth of 2 for SGD w/o momentum, depth of 3 for SGD w/ momentum.");
+  using opmath_t = at::opmath_type<scalar_t>;
+
+  template <typename TLA, typename TLW>
+  void operator()(
+      const int64_t chunk_size,
+      TLA tlAddress,
+      TLW tlWGMeta,
+      sycl::nd_item<1> item_id,
+      const double weight_decay,
+      const double momentum,
+      const float* lr_ptr,
+      const double lr,
+      const double dampening,
+      const bool nesterov,
+      const bool maximize,
+      const bool is_first_step,
+      const float* grad_scale_ptr,
+      const float* found_inf_ptr) const {
+    if (found_inf_ptr && *found_inf_ptr == 1) {
+      return;
+    }
+    auto item_idx = item_id.get_local_id(0);
+    auto item_range = item_id.get_local_range(0);
+    auto group_idx = item_id.get_group(0);
+    int tensor_loc = tlWGMeta[group_idx].wg_to_tensor;
+    int chunk_idx = tlWGMeta[group_idx].wg_to_chunk;
+    int64_t n = tlAddress[tensor_loc].numel_to_tensor;
+    n -= chunk_idx * chunk_size;
+
+    const opmath_t lr_val = lr_ptr ? *lr_ptr : static_cast<opmath_t>(lr);
+    const auto wd = static_cast<opmath_t>(weight_decay);
+    const auto mom = static_cast<opmath_t>(momentum);
+    const auto damp = static_cast<opmath_t>(dampening);
+
+    scalar_t* param =
+        (scalar_t*)tlAddress[tensor_loc].addresses[0] + chunk_idx * chunk_size;
+    scalar_t* grad =
+        (scalar_t*)tlAddress[tensor_loc].addresses[1] + chunk_idx * chunk_size;
+    scalar_t* momentum_buf = nullptr;
+    if constexpr (depth > 2) {
+      momentum_buf = (scalar_t*)tlAddress[tensor_loc].addresses[2] +
+          chunk_idx * chunk_size;
+    }
+
+    for (int64_t i_start = 0; i_start < n && i_start < chunk_size;
+         i_start += item_range * kILP) {
+#pragma unroll
+      for (int ii = 0; ii < kILP; ++ii) {
+        int64_t i = i_start + item_idx + ii * item_range;
+        if (i >= n || i >= chunk_size) {
+          continue;
+        }
+        opmath_t p = static_cast<opmath_t>(param[i]);
+        opmath_t g = static_cast<opmath_t>(grad[i]);
+
+        if (grad_scale_ptr) {
+          g /= static_cast<opmath_t>(*grad_scale_ptr);
+          // Unscaled grads are written back, matching the unfused path.
+          grad[i] = static_cast<scalar_t>(g);
+        }
+        if (maximize) {
+          g = -g;
+        }
+        if (wd != 0) {
+          g += wd * p;
+        }
+        if constexpr (depth > 2) {
+          opmath_t buf = is_first_step
+              ? g
+              : mom * static_cast<opmath_t>(momentum_buf[i]) + (1 - damp) * g;
+          momentum_buf[i] = static_cast<scalar_t>(buf);
+          g = nesterov ? g + mom * buf : buf;
+        }
+        p -= lr_val * g;
+        param[i] = static_cast<scalar_t>(p);
+      }
+    }
+  }
+};
+
+template <int depth>
+void fused_sgd_template(
+    std::vector<std::vector<Tensor>>& tensor_lists,
+    const double weight_decay,
+    const double momentum,
+    const float* lr_ptr,
+    const double lr,
+    const double dampening,
+    const bool nesterov,
+    const bool maximize,
+    const bool is_first_step,
+    const float* grad_scale_ptr,
+    const float* found_inf_ptr) {
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      kHalf,
+      kBFloat16,
+      tensor_lists[0][0].scalar_type(),
+      "fused_sgd_kernel_xpu",
+      [&]() {
+        multi_tensor_apply<depth>(
+            tensor_lists,
+            FusedSgdMathFunctor<scalar_t, depth>(),
+            weight_decay,
+            momentum,
+            lr_ptr,
+            lr,
+            dampening,
+            nesterov,
+            maximize,
+            is_first_step,
+            grad_scale_ptr,
+            found_inf_ptr);
+      });
+}
+
+void fused_sgd_kernel(
+    TensorList params,
+    TensorList grads,
+    TensorList momentum_buffer_list,
+    const double weight_decay,
+    const double momentum,
+    const double lr,
+    const Tensor& lr_tensor,
+    const double dampening,
+    const bool nesterov,
+    const bool maximize,
+    const bool is_first_step,
+    const c10::optional<Tensor>& grad_scale,
+    const c10::optional<Tensor>& found_inf) {
+  const float* lr_ptr =
+      lr_tensor.defined() ? lr_tensor.const_data_ptr<float>() : nullptr;
+  const float* grad_scale_ptr =
+      grad_scale.has_value() ? grad_scale->const_data_ptr<float>() : nullptr;
+  const float* found_inf_ptr =
+      found_inf.has_value() ? found_inf->const_data_ptr<float>() : nullptr;
+
+  if (momentum_buffer_list.empty()) {
+    std::vector<std::vector<Tensor>> tensor_lists{params.vec(), grads.vec()};
+    fused_sgd_template<2>(
+        tensor_lists,
+        weight_decay,
+        momentum,
+        lr_ptr,
+        lr,
+        dampening,
+        nesterov,
+        maximize,
+        is_first_step,
+        grad_scale_ptr,
+        found_inf_ptr);
+  } else {
+    std::vector<std::vector<Tensor>> tensor_lists{
+        params.vec(), grads.vec(), momentum_buffer_list.vec()};
+    fused_sgd_template<3>(
+        tensor_lists,
+        weight_decay,
+        momentum,
+        lr_ptr,
+        lr,
+        dampening,
+        nesterov,
+        maximize,
+        is_first_step,
+        grad_scale_ptr,
+        found_inf_ptr);
+  }
+}
+
+} // namespace at::native::xpu
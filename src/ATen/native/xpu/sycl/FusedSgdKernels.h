@@ -0,0 +1,23 @@
+#pragma once
+#include <ATen/ATen.h>
+
+namespace at::native::xpu {
+
+// `lr` is read from `lr_tensor` on device when it is defined. Momentum
+// buffers are updated only when `momentum_buffer_list` is not empty.
+void fused_sgd_kernel(
+    TensorList params,
+    TensorList grads,
+    TensorList momentum_buffer_list,
+    const double weight_decay,
+    const double momentum,
+    const double lr,
+    const Tensor& lr_tensor,
+    const double dampening,
+    const bool nesterov,
+    const bool maximize,
+    const bool is_first_step,
+    const c10::optional<Tensor>& grad_scale,
+    const c10::optional<Tensor>& found_inf);
+
+} // namespace at::native::xpu
@@ -190,9 +190,13 @@ void histogramdd_linear_kernel(
     leftmost_edge = range.value()[0];
     rightmost_edge = range.value()[1];
   } else if (self.numel() > 0) {
+    // Both extrema in one pass over self and one copy to host
     auto extrema = at::aminmax(self);
-    leftmost_edge = std::get<0>(extrema).item<double>();
-    rightmost_edge = std::get<1>(extrema).item<double>();
+    auto edges = at::stack({std::get<0>(extrema), std::get<1>(extrema)})
+                     .to(kDouble)
+                     .cpu();
+    leftmost_edge = edges.data_ptr<double>()[0];
+    rightmost_edge = edges.data_ptr<double>()[1];
   }
 
   if (leftmost_edge == rightmost_edge) {
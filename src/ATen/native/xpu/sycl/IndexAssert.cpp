@@ -0,0 +1,173 @@
+#include <ATen/native/xpu/sycl/IndexAssert.h>
+#include <c10/util/Exception.h>
+#include <c10/util/Optional.h>
+#include <c10/xpu/XPUFunctions.h>
+#include <c10/xpu/XPUStream.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace at::native::xpu {
+
+namespace {
+
+struct IndexErrorBuffer {
+  // State written by kernels. It lives in host USM, read by the host in
+  // place, if the device supports atomics on host allocations. Otherwise it
+  // lives in device memory and is read into the host mirror.
+  IndexErrorState* state = nullptr;
+  at::DataPtr device_state;
+  IndexErrorState* host = nullptr;
+  // Whether a kernel that records index errors was launched since the last
+  // check.
+  bool pending = false;
+};
+
+// A buffer per stream, so that a reset is ordered after the kernels of the
+// stream that may have recorded into it.
+struct IndexErrorBuffers {
+  std::mutex mutex;
+  std::unordered_map<c10::Stream, IndexErrorBuffer> buffers;
+};
+
+IndexErrorBuffers& index_error_buffers() {
+  // Leaked, so that the buffers outlive the XPU runtime at exit.
+  static auto* buffers = new IndexErrorBuffers();
+  return *buffers;
+}
+
+IndexErrorBuffer& get_buffer(
+    IndexErrorBuffers& buffers,
+    c10::xpu::XPUStream stream) {
+  auto& buffer = buffers.buffers[stream.unwrap()];
+  if (!buffer.host) {
+    auto& queue = stream.queue();
+    buffer.host = sycl::malloc_host<IndexErrorState>(1, queue);
+    TORCH_CHECK(buffer.host, "XPU: failed to allocate index error buffer");
+    std::memset(buffer.host, 0, sizeof(IndexErrorState));
+    if (queue.get_device().has(sycl::aspect::usm_atomic_host_allocations)) {
+      buffer.state = buffer.host;
+    } else {
+      buffer.device_state =
+          c10::GetAllocator(kXPU)->allocate(sizeof(IndexErrorState));
+      buffer.state = static_cast<IndexErrorState*>(buffer.device_state.get());
+      queue.memset(buffer.state, 0, sizeof(IndexErrorState));
+    }
+  }
+  return buffer;
+}
+
+// Takes the error in the host mirror, resetting the state.
+c10::optional<IndexErrorState> take_error(
+    IndexErrorBuffer& buffer,
+    sycl::queue& queue) {
+  if (buffer.host->flag != kIndexErrorRecorded) {
+    return c10::nullopt;
+  }
+  IndexErrorState error = *buffer.host;
+  std::memset(buffer.host, 0, sizeof(IndexErrorState));
+  if (buffer.state != buffer.host) {
+    queue.memset(buffer.state, 0, sizeof(IndexErrorState));
+  }
+  return error;
+}
+
+void raise_index_error(const IndexErrorState& error) {
+  if (error.dim >= 0) {
+    TORCH_CHECK_INDEX(
+        false,
+        "index ",
+        error.index,
+        " is out of bounds for dimension ",
+        error.dim,
+        " with size ",
+        error.size,
+        " (found by an XPU kernel, which may precede the current op)");
+  }
+  TORCH_CHECK_INDEX(
+      false,
+      "index ",
+      error.index,
+      " is out of bounds for size ",
+      error.size,
+      " (found by an XPU kernel, which may precede the current op)");
+}
+
+// Reads the state of buffer, waiting for queue unless it is known to be idle,
+// and takes a recorded error. Host USM state is read in place.
+c10::optional<IndexErrorState> read_error(
+    IndexErrorBuffer& buffer,
+    sycl::queue& queue,
+    bool idle) {
+  if (buffer.state != buffer.host) {
+    queue.memcpy(buffer.host, buffer.state, sizeof(IndexErrorState)).wait();
+  } else if (!idle) {
+    queue.wait();
+  }
+  buffer.pending = false;
+  return take_error(buffer, queue);
+}
+
+} // namespace
+
+IndexErrorRecorder get_index_error_recorder() {
+  auto stream = c10::xpu::getCurrentXPUStream();
+  auto& buffers = index_error_buffers();
+  std::lock_guard<std::mutex> lock(buffers.mutex);
+  auto& buffer = get_buffer(buffers, stream);
+  buffer.pending = true;
+  return {buffer.state};
+}
+
+void check_index_errors() {
+  auto device = c10::xpu::current_device();
+  auto& buffers = index_error_buffers();
+  c10::optional<IndexErrorState> error;
+  {
+    std::lock_guard<std::mutex> lock(buffers.mutex);
+    for (auto& [stream, buffer] : buffers.buffers) {
+      if (stream.device_index() != device || !buffer.pending) {
+        continue;
+      }
+      auto e = read_error(
+          buffer, c10::xpu::XPUStream(stream).queue(), /*idle=*/false);
+      if (!error) {
+        error = e;
+      }
+    }
+  }
+  if (error) {
+    raise_index_error(*error);
+  }
+}
+
+void check_index_errors_after_sync() {
+  auto stream = c10::xpu::getCurrentXPUStream();
+  auto& buffers = index_error_buffers();
+  c10::optional<IndexErrorState> error;
+  {
+    std::lock_guard<std::mutex> lock(buffers.mutex);
+    auto it = buffers.buffers.find(stream.unwrap());
+    if (it == buffers.buffers.end() || !it->second.pending) {
+      return;
+    }
+    error = read_error(it->second, stream.queue(), /*idle=*/true);
+  }
+  if (error) {
+    raise_index_error(*error);
+  }
+}
+
+void maybe_sync_index_errors() {
+  static const bool sync = [] {
+    const char* env = std::getenv("PYTORCH_XPU_SYNC_INDEX_CHECK");
+    return env && std::strcmp(env, "1") == 0;
+  }();
+  if (sync) {
+    check_index_errors();
+  }
+}
+
+} // namespace at::native::xpu
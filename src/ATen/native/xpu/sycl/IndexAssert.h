@@ -0,0 +1,78 @@
+#pragma once
+
+#include <comm/SYCLContext.h>
+
+namespace at::native::xpu {
+
+// Out of bounds indices found by kernels, reported without a host sync. A
+// kernel records the first offending index into a per-stream buffer and goes
+// on with a safe index. The host raises the error at a later check, never in
+// the launch of another op:
+// - at a sync point of the stream, i.e. a blocking copy to the host such as
+//   .cpu() or .item(),
+// - in check_index_errors(), which waits for the streams of the device. It is
+//   exposed as torch.ops.torch_xpu_ops._check_index_errors(), e.g. for the
+//   end of a training step, since torch.xpu.synchronize() is not a check,
+// - right after the offending launch, with PYTORCH_XPU_SYNC_INDEX_CHECK=1.
+// flag is kIndexErrorRecording while the recording kernel fills in the other
+// fields, and kIndexErrorRecorded once they are complete.
+constexpr int32_t kIndexErrorRecording = 1;
+constexpr int32_t kIndexErrorRecorded = 2;
+
+struct IndexErrorState {
+  int32_t flag;
+  int32_t dim;
+  int64_t index;
+  int64_t size;
+};
+
+// Captured by kernels to record index errors.
+struct IndexErrorRecorder {
+  // Records index as out of bounds of a dim of size size, unless an error
+  // is already pending. dim is -1 if unknown to the kernel.
+  void record(int64_t index, int64_t size, int32_t dim = -1) const {
+    sycl::atomic_ref<
+        int32_t,
+        sycl::memory_order::relaxed,
+        sycl::memory_scope::device,
+        sycl::access::address_space::global_space>
+        flag(state_->flag);
+    int32_t expected = 0;
+    if (flag.compare_exchange_strong(expected, kIndexErrorRecording)) {
+      state_->dim = dim;
+      state_->index = index;
+      state_->size = size;
+      flag.store(kIndexErrorRecorded, sycl::memory_order::release);
+    }
+  }
+
+  // Returns whether index is within [-size, size), and records it if not.
+  bool check(int64_t index, int64_t size, int32_t dim = -1) const {
+    if (C10_LIKELY(index >= -size && index < size)) {
+      return true;
+    }
+    record(index, size, dim);
+    return false;
+  }
+
+  IndexErrorState* state_;
+};
+
+// Returns the recorder for a kernel launched next on the current stream.
+IndexErrorRecorder get_index_error_recorder();
+
+// Raises an index error of a launch just submitted, if
+// PYTORCH_XPU_SYNC_INDEX_CHECK=1 is set.
+void maybe_sync_index_errors();
+
+// Waits for the streams of the current device that ran kernels recording
+// index errors, and raises a pending index error.
+void check_index_errors();
+
+// Raises a pending index error once the current stream has been waited for.
+// Free when no kernel that records index errors ran since the last check.
+// Otherwise it is a host load on devices with atomics on host USM, and a
+// 24-byte copy to the host on other devices.
+void check_index_errors_after_sync();
+
+} // namespace at::native::xpu
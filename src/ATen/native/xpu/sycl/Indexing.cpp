@@ -8,6 +8,7 @@
 #include <ATen/AccumulateType.h>
 #include <ATen/Dispatch.h>
 #include <ATen/MemoryOverlap.h>
+#include <ATen/native/ReductionType.h>
 #include <ATen/native/Resize.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/xpu/sycl/Atomics.h>
@@ -24,6 +25,40 @@ using namespace at::xpu;
 
 namespace at::native::xpu {
 
+template <typename index_t>
+struct WrapIndexFunctor {
+  index_t operator()(index_t index) const {
+    if (!recorder_.check(index, dim_size_, dim_)) {
+      return 0;
+    }
+    return index < 0 ? index + dim_size_ : index;
+  }
+  WrapIndexFunctor(int64_t dim_size, int32_t dim, IndexErrorRecorder recorder)
+      : dim_size_(dim_size), dim_(dim), recorder_(recorder) {}
+
+ private:
+  int64_t dim_size_;
+  int32_t dim_;
+  IndexErrorRecorder recorder_;
+};
+
+Tensor wrap_index_kernel(const Tensor& index, int64_t dim, int64_t dim_size) {
+  Tensor result = at::empty_like(index, at::MemoryFormat::Contiguous);
+  auto iter = TensorIteratorConfig()
+                  .add_output(result)
+                  .add_input(index)
+                  .check_all_same_dtype(true)
+                  .build();
+  AT_DISPATCH_INDEX_TYPES(iter.dtype(), "wrap_index_xpu", [&] {
+    gpu_kernel(
+        iter,
+        WrapIndexFunctor<index_t>(
+            dim_size, static_cast<int32_t>(dim), get_index_error_recorder()));
+  });
+  maybe_sync_index_errors();
+  return result;
+}
+
 template <typename dtype>
 struct IndexFunctor {
   void operator()(char* out_data, char* in_data, int64_t offset) const {
@@ -429,6 +464,300 @@ void index_add_kernel(
       });
 }
 
+template <typename ValType>
+struct IndexReduceMultiplyFunctor {
+  void operator()(
+      ValType* dst,
+      ValType* src,
+      int64_t dst_off,
+      int64_t src_off,
+      int64_t idx,
+      ValType alpha) const {
+    atomicMul((sycl_global_ptr<ValType>)(dst + dst_off), src[src_off]);
+  }
+};
+
+template <typename ValType>
+struct IndexReduceMeanFunctor {
+  void operator()(
+      ValType* dst,
+      ValType* src,
+      int64_t dst_off,
+      int64_t src_off,
+      int64_t idx,
+      ValType alpha) const {
+    atomicAdd((sycl_global_ptr<ValType>)(dst + dst_off), src[src_off]);
+  }
+};
+
+template <typename ValType>
+struct IndexReduceMaxFunctor {
+  void operator()(
+      ValType* dst,
+      ValType* src,
+      int64_t dst_off,
+      int64_t src_off,
+      int64_t idx,
+      ValType alpha) const {
+    atomicMax((sycl_global_ptr<ValType>)(dst + dst_off), src[src_off]);
+  }
+};
+
+template <typename ValType>
+struct IndexReduceMinFunctor {
+  void operator()(
+      ValType* dst,
+      ValType* src,
+      int64_t dst_off,
+      int64_t src_off,
+      int64_t idx,
+      ValType alpha) const {
+    atomicMin((sycl_global_ptr<ValType>)(dst + dst_off), src[src_off]);
+  }
+};
+
+template <template <typename> class func_t>
+static void index_reduce_func_impl(
+    const Tensor& self_,
+    int64_t dim,
+    const Tensor& index,
+    const Tensor& source_) {
+  AT_DISPATCH_ALL_TYPES_AND2(
+      at::ScalarType::Half,
+      at::ScalarType::BFloat16,
+      source_.scalar_type(),
+      "index_reduce_xpu",
+      [&] {
+        AT_DISPATCH_INDEX_TYPES(index.scalar_type(), "index_reduce_xpu", [&]() {
+          TensorInfo<index_t, int64_t> index_info =
+              getTensorInfo<index_t, int64_t>(index);
+          index_info.collapseDims();
+
+          TensorInfo<scalar_t, int64_t> src_info =
+              getTensorInfo<scalar_t, int64_t>(source_);
+
+          TensorInfo<scalar_t, int64_t> dst_info =
+              getTensorInfo<scalar_t, int64_t>(self_);
+          int new_indexing_dim = dst_info.collapseDims(dim);
+
+          using IdxConfig = IndexKernelConfig<
+              decltype(src_info),
+              decltype(dst_info),
+              decltype(index_info),
+              func_t<scalar_t>>;
+          using KernelClass = IndexKernel<IdxConfig, false, false>;
+
+          auto cfg = IdxConfig::template make_config<KernelClass>(
+              src_info,
+              dst_info,
+              index_info,
+              static_cast<scalar_t>(1),
+              new_indexing_dim,
+              true,
+              func_t<scalar_t>());
+          launch_index_kernel(cfg);
+        });
+      });
+}
+
+void index_reduce_kernel(
+    const Tensor& self,
+    int64_t dim,
+    const Tensor& index,
+    const Tensor& source,
+    bool include_self,
+    const ReductionType& reduce,
+    const Tensor& result) {
+  globalContext().alertNotDeterministic("index_reduce_xpu");
+
+  if (!result.is_same(self)) {
+    result.copy_(self);
+  }
+
+  // Scalars are treated as 1-d tensor
+  Tensor self_ = (result.dim() == 0) ? result.view(1) : result;
+  Tensor source_ = (source.dim() == 0) ? source.view(1) : source;
+
+  TORCH_CHECK(
+      result.dim() <= XPU_MAX_TENSORINFO_DIMS,
+      "tensor has too many (>",
+      XPU_MAX_TENSORINFO_DIMS,
+      ") dims");
+  TORCH_CHECK(
+      source.dim() <= XPU_MAX_TENSORINFO_DIMS,
+      "tensor has too many (>",
+      XPU_MAX_TENSORINFO_DIMS,
+      ") dims");
+  TORCH_CHECK(
+      index.dim() <= XPU_MAX_TENSORINFO_DIMS,
+      "tensor has too many (>",
+      XPU_MAX_TENSORINFO_DIMS,
+      ") dims");
+
+  if (!include_self) {
+    AT_DISPATCH_ALL_TYPES_AND2(
+        at::ScalarType::Half,
+        at::ScalarType::BFloat16,
+        self.scalar_type(),
+        "index_reduce_func_xpu_exclude_input_init",
+        [&] {
+          scalar_t init_val;
+          switch (reduce) {
+            case ReductionType::PROD:
+              init_val = (scalar_t)1;
+              break;
+            case ReductionType::MAX:
+              init_val = std::numeric_limits<scalar_t>::has_infinity
+                  ? -std::numeric_limits<scalar_t>::infinity()
+                  : std::numeric_limits<scalar_t>::lowest();
+              break;
+            case ReductionType::MIN:
+              init_val = std::numeric_limits<scalar_t>::has_infinity
+                  ? std::numeric_limits<scalar_t>::infinity()
+                  : std::numeric_limits<scalar_t>::max();
+              break;
+            default:
+              init_val = (scalar_t)0;
+              break;
+          }
+          // index_fill_ requires index to be a LongTensor
+          self_.index_fill_(dim, index.to(at::ScalarType::Long), init_val);
+        });
+  }
+
+  const ptrdiff_t sliceSize = getSliceSize(self_, dim, index, source_);
+  if (sliceSize != 0 && index.numel() != 0) {
+    switch (reduce) {
+      case ReductionType::PROD:
+        index_reduce_func_impl<IndexReduceMultiplyFunctor>(
+            self_, dim, index, source_);
+        break;
+      case ReductionType::MEAN:
+        index_reduce_func_impl<IndexReduceMeanFunctor>(
+            self_, dim, index, source_);
+        break;
+      case ReductionType::MAX:
+        index_reduce_func_impl<IndexReduceMaxFunctor>(
+            self_, dim, index, source_);
+        break;
+      case ReductionType::MIN:
+        index_reduce_func_impl<IndexReduceMinFunctor>(
+            self_, dim, index, source_);
+        break;
+      default:
+        TORCH_INTERNAL_ASSERT(false, "index_reduce(): unsupported reduce");
+    }
+  }
+
+  if (reduce == ReductionType::MEAN) {
+    auto counts = include_self ? at::ones_like(result) : at::zeros_like(result);
+    counts.index_add_(dim, index, at::ones_like(source));
+    counts.masked_fill_(counts == 0, 1);
+    if (result.is_floating_point() || result.is_complex()) {
+      result.div_(counts);
+    } else {
+      result.div_(counts, "floor");
+    }
+  }
+}
+
+template <typename ValType>
+struct IndexCopyFunctor {
+  void operator()(
+      ValType* dst,
+      ValType* src,
+      int64_t dst_off,
+      int64_t src_off,
+      int64_t idx,
+      ValType alpha) const {
+    dst[dst_off] = src[src_off];
+  }
+};
+
+void index_copy_kernel(
+    const Tensor& self,
+    int64_t dim,
+    const Tensor& index,
+    const Tensor& source,
+    const Tensor& result) {
+  if (!result.is_same(self)) {
+    result.copy_(self);
+  }
+
+  // See Note [Enabling Deterministic Operations]
+  if (globalContext().deterministicAlgorithms()) {
+    torch::List<c10::optional<Tensor>> indices;
+    indices.reserve(dim + 1);
+    for (int i = 0; i < dim; i++) {
+      indices.emplace_back();
+    }
+    indices.emplace_back(index);
+    result.index_put_(indices, source, false);
+    return;
+  }
+
+  if (index.numel() == 0 || result.numel() == 0) {
+    return;
+  }
+
+  // Scalars are treated as 1-d tensor
+  const Tensor self_ = (result.dim() == 0) ? result.view(1) : result;
+  const Tensor source_ = (source.dim() == 0) ? source.view(1) : source;
+
+  TORCH_CHECK(
+      result.dim() <= XPU_MAX_TENSORINFO_DIMS,
+      "tensor has too many (>",
+      XPU_MAX_TENSORINFO_DIMS,
+      ") dims");
+  TORCH_CHECK(
+      source.dim() <= XPU_MAX_TENSORINFO_DIMS,
+      "tensor has too many (>",
+      XPU_MAX_TENSORINFO_DIMS,
+      ") dims");
+
+  const ptrdiff_t sliceSize = getSliceSize(self_, dim, index, source_);
+  if (sliceSize == 0) {
+    return;
+  }
+
+  AT_DISPATCH_ALL_TYPES_AND_COMPLEX_AND4(
+      at::ScalarType::Bool,
+      at::ScalarType::Half,
+      at::ScalarType::BFloat16,
+      at::ScalarType::ComplexHalf,
+      source_.scalar_type(),
+      "index_copy_xpu",
+      [&] {
+        TensorInfo<int64_t, int64_t> index_info =
+            getTensorInfo<int64_t, int64_t>(index);
+        index_info.collapseDims();
+
+        TensorInfo<scalar_t, int64_t> src_info =
+            getTensorInfo<scalar_t, int64_t>(source_);
+
+        TensorInfo<scalar_t, int64_t> dst_info =
+            getTensorInfo<scalar_t, int64_t>(self_);
+        int new_indexing_dim = dst_info.collapseDims(dim);
+
+        using IdxConfig = IndexKernelConfig<
+            decltype(src_info),
+            decltype(dst_info),
+            decltype(index_info),
+            IndexCopyFunctor<scalar_t>>;
+        using KernelClass = IndexKernel<IdxConfig, false, false>;
+
+        auto cfg = IdxConfig::template make_config<KernelClass>(
+            src_info,
+            dst_info,
+            index_info,
+            scalar_t(),
+            new_indexing_dim,
+            true,
+            IndexCopyFunctor<scalar_t>());
+        launch_index_kernel(cfg);
+      });
+}
+
 template <typename ValType>
 struct IndexFillScalarFunctor {
   void operator()(
@@ -628,12 +957,19 @@ void index_put_deterministic_kernel(
         orig_indices.data_ptr<int64_t>(),
         orig_indices.data_ptr<int64_t>() + linearIndex.numel(),
         (int64_t)0);
+    // Linear indices address slices of src, which bounds the key bits the
+    // radix sort has to process.
+    int64_t largest_index = 0;
+    for (int64_t d = 0; d < src.dim(); d++) {
+      largest_index += (src.size(d) - 1) * src.stride(d);
+    }
     pstl::sort<int64_t, int64_t>(
         linearIndex.data_ptr<int64_t>(),
         sorted_indices.data_ptr<int64_t>(),
         orig_indices.data_ptr<int64_t>(),
         linearIndex.numel(),
-        false);
+        false,
+        largest_index / sliceSize + 1);
     TORCH_INTERNAL_ASSERT(
         linearIndex.numel() * sliceSize * nElemBefore == expandedValue.numel(),
         "number of flattened indices did not match number of elements in the value tensor: ",
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <ATen/native/xpu/sycl/BatchKernel.h>
+#include <ATen/native/xpu/sycl/IndexAssert.h>
 #include <ATen/native/xpu/sycl/Loops.h>
 #include <comm/TensorInfo.h>
+#include <comm/TensorOptions.h>
 
 using namespace at::xpu::detail;
 using namespace at::xpu;
@@ -197,9 +199,12 @@ class IndexKernel {
   using IdxType = typename IdxConfig::IdxType;
 
   IndexKernel() = delete;
-  IndexKernel(IdxConfig& cfg) : cfg_(cfg) {}
+  IndexKernel(IdxConfig& cfg, IndexErrorRecorder recorder)
+      : cfg_(cfg), recorder_(recorder) {}
 
-  void init_global_batch_info(
+  // Returns false for an out of bounds index, which is recorded and replaced
+  // by 0.
+  bool init_global_batch_info(
       BatchKernelConfig::ItemDesc& id,
       int64_t& idx_logical_off,
       int64_t& glb_batch_group,
@@ -216,9 +221,15 @@ class IndexKernel {
     }
     glb_batch_group = id.glb_batch / cfg_.index_num_;
     glb_batch_group_loc_off = cfg_.iinfo_.data[idx_off];
+    if (!recorder_.check(
+            glb_batch_group_loc_off, cfg_.indexing_dimension_size_)) {
+      glb_batch_group_loc_off = 0;
+      return false;
+    }
     glb_batch_group_loc_off = glb_batch_group_loc_off >= 0
         ? glb_batch_group_loc_off
         : cfg_.indexing_dimension_size_ + glb_batch_group_loc_off;
+    return true;
   }
 
   int64_t inline indexing_logical_off(
@@ -296,8 +307,14 @@ class IndexKernel {
     int64_t glb_indexing_logical_off, glb_fixing_logical_off;
     int64_t dst_off, src_off;
 
-    init_global_batch_info(
-        id, idx_logical_off, glb_batch_group, glb_batch_group_loc_off);
+    // An out of bounds index leaves the indexed operand (index_add,
+    // index_fill, index_copy) untouched, and gathers from index 0 otherwise,
+    // so that the output is still fully written.
+    if (!init_global_batch_info(
+            id, idx_logical_off, glb_batch_group, glb_batch_group_loc_off) &&
+        cfg_.indexing_dst_) {
+      return;
+    }
 
     glb_indexing_logical_off =
         indexing_logical_off(id, glb_batch_group, glb_batch_group_loc_off);
@@ -353,6 +370,7 @@ class IndexKernel {
 
  private:
   IdxConfig cfg_;
+  IndexErrorRecorder recorder_;
 };
 
 template <
@@ -361,8 +379,10 @@ template <
     bool KnownProblemInner = false>
 static inline void launch_index_kernel(IdxConfig& cfg) {
   auto& queue = getCurrentSYCLQueue();
-  IndexKernel<IdxConfig, TrivialOffCal, KnownProblemInner> idx_ker(cfg);
+  IndexKernel<IdxConfig, TrivialOffCal, KnownProblemInner> idx_ker(
+      cfg, get_index_error_recorder());
   sycl_kernel_submit(cfg.global_size(), cfg.group_size(), queue, idx_ker);
+  maybe_sync_index_errors();
 }
 
 template <typename func_t, typename index_buf_type>
@@ -382,9 +402,9 @@ struct SmallIndexKernelFunctor : public __SYCL_KER_CONFIG_CONVENTION__ {
         if (indice_size_bytes_ == 4) {
           int32_t index =
               *(int32_t*)(index_ptrs_[i] + local_index * indice_size_bytes_);
-          SYCL_KERNEL_ASSERT(
-              index >= -sizes_[i] && index < sizes_[i] &&
-              "index out of bounds");
+          if (!recorder_.check(index, sizes_[i])) {
+            index = 0;
+          }
           if (index < 0) {
             index += sizes_[i];
           }
@@ -392,9 +412,9 @@ struct SmallIndexKernelFunctor : public __SYCL_KER_CONFIG_CONVENTION__ {
         } else {
           int64_t index =
               *(int64_t*)(index_ptrs_[i] + local_index * indice_size_bytes_);
-          SYCL_KERNEL_ASSERT(
-              index >= -sizes_[i] && index < sizes_[i] &&
-              "index out of bounds");
+          if (!recorder_.check(index, sizes_[i])) {
+            index = 0;
+          }
           if (index < 0) {
             index += sizes_[i];
           }
@@ -459,7 +479,8 @@ struct SmallIndexKernelFunctor : public __SYCL_KER_CONFIG_CONVENTION__ {
       int64_t indice_size_bytes,
       char* out_data,
       char* in_data,
-      at::detail::Array<index_buf_type, XPU_MAX_TENSORINFO_DIMS> index_ptrs)
+      at::detail::Array<index_buf_type, XPU_MAX_TENSORINFO_DIMS> index_ptrs,
+      IndexErrorRecorder recorder)
       : f_(f),
         indices_size_(indices_size),
         group_num_tail_(group_num_tail),
@@ -479,6 +500,7 @@ struct SmallIndexKernelFunctor : public __SYCL_KER_CONFIG_CONVENTION__ {
         out_data_(out_data),
         in_data_(in_data),
         index_ptrs_(index_ptrs),
+        recorder_(recorder),
         local_offset_() {}
 
  private:
@@ -501,6 +523,7 @@ struct SmallIndexKernelFunctor : public __SYCL_KER_CONFIG_CONVENTION__ {
   char* out_data_;
   char* in_data_;
   at::detail::Array<index_buf_type, XPU_MAX_TENSORINFO_DIMS> index_ptrs_;
+  IndexErrorRecorder recorder_;
   sycl_local_acc_t<int64_t, 1> local_offset_;
 };
 
@@ -585,9 +608,11 @@ void small_index_kernel(
       indice_size_bytes,
       out_data,
       in_data,
-      index_ptrs);
+      index_ptrs,
+      get_index_error_recorder());
   sycl_kernel_submit(
       sycl::range<1>(global_size), sycl::range<1>(wgroup_size), queue, kfn);
+  maybe_sync_index_errors();
 }
 
 template <
@@ -608,16 +633,18 @@ struct IndexKernelFunctor {
       // with numbers of input datatypes.
       if (indice_size_bytes_ == 4) {
         int32_t index = *(int32_t*)(index_ptrs_[i] + offsets[2]);
-        SYCL_KERNEL_ASSERT(
-            index >= -sizes_[i] && index < sizes_[i] && "index out of bounds");
+        if (!recorder_.check(index, sizes_[i])) {
+          index = 0;
+        }
         if (index < 0) {
           index += sizes_[i];
         }
         offset += index * strides_[i];
       } else {
         int64_t index = *(int64_t*)(index_ptrs_[i] + offsets[2]);
-        SYCL_KERNEL_ASSERT(
-            index >= -sizes_[i] && index < sizes_[i] && "index out of bounds");
+        if (!recorder_.check(index, sizes_[i])) {
+          index = 0;
+        }
         if (index < 0) {
           index += sizes_[i];
         }
@@ -635,7 +662,8 @@ struct IndexKernelFunctor {
       size_t num_indices,
       at::detail::Array<index_buf_type, XPU_MAX_TENSORINFO_DIMS> index_ptrs,
       at::detail::Array<int64_t, XPU_MAX_TENSORINFO_DIMS> sizes,
-      at::detail::Array<int64_t, XPU_MAX_TENSORINFO_DIMS> strides)
+      at::detail::Array<int64_t, XPU_MAX_TENSORINFO_DIMS> strides,
+      IndexErrorRecorder recorder)
       : f_(f),
         offset_calc_(offset_calc),
         indice_size_bytes_(indice_size_bytes),
@@ -644,7 +672,8 @@ struct IndexKernelFunctor {
         num_indices_(num_indices),
         index_ptrs_(index_ptrs),
         sizes_(sizes),
-        strides_(strides) {}
+        strides_(strides),
+        recorder_(recorder) {}
 
  private:
   const func_t f_;
@@ -656,6 +685,7 @@ struct IndexKernelFunctor {
   at::detail::Array<index_buf_type, XPU_MAX_TENSORINFO_DIMS> index_ptrs_;
   at::detail::Array<int64_t, XPU_MAX_TENSORINFO_DIMS> sizes_;
   at::detail::Array<int64_t, XPU_MAX_TENSORINFO_DIMS> strides_;
+  IndexErrorRecorder recorder_;
 };
 
 template <typename func_t>
@@ -694,8 +724,10 @@ void index_kernel_impl(
       num_indices,
       index_ptrs,
       sizes,
-      strides);
+      strides,
+      get_index_error_recorder());
   sycl_kernel_submit(sycl::range<1>(numel), queue, kfn);
+  maybe_sync_index_errors();
 }
 
 template <typename func_t>
@@ -782,6 +814,62 @@ void _index_kernel(
   index_kernel_impl<func_t>(iter, index_size, index_stride, f);
 }
 
+// Sorted indices are split into chunks of kIndexPutChunkRows. The sum of a
+// chunk holding a single index is computed ahead, so that a work-item
+// accumulating a long segment of equal indices steps over whole chunks.
+constexpr int64_t kIndexPutChunkRows = 64;
+
+template <typename scalar_t, typename accscalar_t>
+struct IndexPutChunkSumKernelFunctor {
+  void operator()(sycl::nd_item<2> item) const {
+    auto id = cfg_.get_item_desc(item);
+
+    if (id.glb_batch >= cfg_.problem_batch_ || id.glb_problem >= cfg_.problem_)
+      return;
+
+    int64_t begin = id.glb_batch * kIndexPutChunkRows;
+    int64_t end = begin + kIndexPutChunkRows;
+    if (sorted_indices_[begin] != sorted_indices_[end - 1])
+      return;
+
+    int64_t pi_ = id.glb_problem;
+    int64_t si_ = pi_ % stride_;
+    int64_t bi_ = pi_ / stride_;
+    int64_t v_stride = si_ + bi_ * v_stride_before_;
+
+    accscalar_t acc = value_[indices_[begin] * stride_ + v_stride];
+    for (int64_t inner_idx = begin + 1; inner_idx < end; inner_idx++) {
+      acc += (accscalar_t)value_[indices_[inner_idx] * stride_ + v_stride];
+    }
+    chunk_sums_[id.glb_batch * cfg_.problem_ + pi_] = acc;
+  }
+
+  IndexPutChunkSumKernelFunctor(
+      int64_t* sorted_indices,
+      int64_t* indices,
+      scalar_t* value,
+      accscalar_t* chunk_sums,
+      int64_t stride,
+      int64_t v_stride_before,
+      BatchKernelConfig cfg)
+      : sorted_indices_(sorted_indices),
+        indices_(indices),
+        value_(value),
+        chunk_sums_(chunk_sums),
+        stride_(stride),
+        v_stride_before_(v_stride_before),
+        cfg_(cfg) {}
+
+ private:
+  int64_t* sorted_indices_;
+  int64_t* indices_;
+  scalar_t* value_;
+  accscalar_t* chunk_sums_;
+  int64_t stride_;
+  int64_t v_stride_before_;
+  BatchKernelConfig cfg_;
+};
+
 template <typename scalar_t, typename accscalar_t>
 struct IndexPutDeterministicKernelFunctor {
   void operator()(sycl::nd_item<2> item) const {
@@ -806,6 +894,14 @@ struct IndexPutDeterministicKernelFunctor {
     for (int64_t inner_idx = id.glb_batch;
          inner_idx < cfg_.problem_batch_ && sorted_indices_[inner_idx] == idx;
          inner_idx++) {
+      if (chunk_sums_ && inner_idx % kIndexPutChunkRows == 0 &&
+          inner_idx + kIndexPutChunkRows <= cfg_.problem_batch_ &&
+          sorted_indices_[inner_idx + kIndexPutChunkRows - 1] == idx) {
+        int64_t chunk = inner_idx / kIndexPutChunkRows;
+        acc += chunk_sums_[chunk * cfg_.problem_ + pi_];
+        inner_idx += kIndexPutChunkRows - 1;
+        continue;
+      }
       int64_t idx_orig = indices_[inner_idx];
       int64_t v_gid = idx_orig * stride_ + v_stride;
       if (accumulate_) {
@@ -828,6 +924,7 @@ struct IndexPutDeterministicKernelFunctor {
       int64_t stride_before,
       bool accumulate,
       int64_t v_stride_before,
+      accscalar_t* chunk_sums,
       BatchKernelConfig cfg)
       : sorted_indices_(sorted_indices),
         indices_(indices),
@@ -837,6 +934,7 @@ struct IndexPutDeterministicKernelFunctor {
         stride_before_(stride_before),
         accumulate_(accumulate),
         v_stride_before_(v_stride_before),
+        chunk_sums_(chunk_sums),
         cfg_(cfg) {}
 
  private:
@@ -848,6 +946,7 @@ struct IndexPutDeterministicKernelFunctor {
   int64_t stride_before_;
   bool accumulate_;
   int64_t v_stride_before_;
+  accscalar_t* chunk_sums_;
   BatchKernelConfig cfg_;
 };
 
@@ -881,6 +980,43 @@ void launch_index_put_deterministic_kernel(
 
   cfg.template build<KernelClass>();
 
+  // Skewed indices make long segments, which are summed up chunk by chunk
+  // rather than element by element, still without atomics.
+  Tensor chunk_sums;
+  accscalar_t* chunk_sums_ptr = nullptr;
+  if (accumulate && numel >= 2 * kIndexPutChunkRows) {
+    int64_t num_chunks = numel / kIndexPutChunkRows;
+    chunk_sums = at::empty(
+        {num_chunks * outer_dim * stride * (int64_t)sizeof(accscalar_t)},
+        map_options<uint8_t>());
+    chunk_sums_ptr = reinterpret_cast<accscalar_t*>(chunk_sums.data_ptr());
+
+    using ChunkKernelClass =
+        IndexPutChunkSumKernelFunctor<scalar_t, accscalar_t>;
+    BatchKernelConfig chunk_cfg = {
+        num_chunks,
+        outer_dim * stride,
+        1,
+        num_chunks,
+        true,
+        {BatchKernelConfig::Policy::pSegment,
+         BatchKernelConfig::Policy::pAggressiveSplit}};
+    chunk_cfg.template build<ChunkKernelClass>();
+    ChunkKernelClass chunk_kfn(
+        sorted_indices,
+        indices,
+        value,
+        chunk_sums_ptr,
+        stride,
+        v_stride_before,
+        chunk_cfg);
+    sycl_kernel_submit(
+        chunk_cfg.global_size(),
+        chunk_cfg.group_size(),
+        getCurrentSYCLQueue(),
+        chunk_kfn);
+  }
+
   KernelClass kfn(
       sorted_indices,
       indices,
@@ -890,6 +1026,7 @@ void launch_index_put_deterministic_kernel(
       stride_before,
       accumulate,
       v_stride_before,
+      chunk_sums_ptr,
       cfg);
 
   sycl_kernel_submit(
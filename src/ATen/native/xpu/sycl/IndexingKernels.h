@@ -1,4 +1,5 @@
 #pragma once
+#include <ATen/native/ReductionType.h>
 #include <ATen/native/TensorIterator.h>
 
 namespace at::native::xpu {
@@ -26,6 +27,22 @@ void index_add_kernel(
     const Scalar& alpha,
     const Tensor& out);
 
+void index_copy_kernel(
+    const Tensor& self,
+    int64_t dim,
+    const Tensor& index,
+    const Tensor& source,
+    const Tensor& result);
+
+void index_reduce_kernel(
+    const Tensor& self,
+    int64_t dim,
+    const Tensor& index,
+    const Tensor& source,
+    bool include_self,
+    const ReductionType& reduce,
+    const Tensor& result);
+
 void index_fill_kernel(
     Tensor& self,
     int64_t dim,
@@ -7,6 +7,10 @@
 
 namespace at::native::xpu {
 
+// Wraps negative indices of an XPU index tensor, recording out of bounds
+// ones as index errors instead of syncing with the host.
+Tensor wrap_index_kernel(const Tensor& index, int64_t dim, int64_t dim_size);
+
 static Tensor wrapIndexOnce(
     const Tensor& index,
     int64_t dim,
@@ -14,29 +18,34 @@ static Tensor wrapIndexOnce(
     bool check_range = true) {
   // we don't need to check range in backward - if there were out of bounds
   // indices forward should already have errored out
-  if (index.numel() != 0 && check_range) {
-    auto max_idx = index.max().item<int64_t>();
-    auto min_idx = index.min().item<int64_t>();
-    if (max_idx >= dim_size) {
-      TORCH_CHECK_INDEX(
-          false,
-          "index ",
-          max_idx,
-          " is out of bounds for dimension ",
-          dim,
-          " with size ",
-          dim_size);
-    }
-    if (min_idx < -dim_size) {
-      TORCH_CHECK_INDEX(
-          false,
-          "index ",
-          min_idx,
-          " is out of bounds for dimension ",
-          dim,
-          " with size ",
-          dim_size);
-    }
+  if (index.numel() == 0 || !check_range) {
+    return index.remainder(dim_size);
+  }
+  if (index.is_xpu()) {
+    return wrap_index_kernel(index, dim, dim_size);
+  }
+  // Checking a host index does not sync with the device.
+  auto max_idx = index.max().item<int64_t>();
+  auto min_idx = index.min().item<int64_t>();
+  if (max_idx >= dim_size) {
+    TORCH_CHECK_INDEX(
+        false,
+        "index ",
+        max_idx,
+        " is out of bounds for dimension ",
+        dim,
+        " with size ",
+        dim_size);
+  }
+  if (min_idx < -dim_size) {
+    TORCH_CHECK_INDEX(
+        false,
+        "index ",
+        min_idx,
+        " is out of bounds for dimension ",
+        dim,
+        " with size ",
+        dim_size);
   }
   return index.remainder(dim_size);
 }
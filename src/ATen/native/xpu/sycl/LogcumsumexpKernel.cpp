@@ -0,0 +1,90 @@
+#include <ATen/Dispatch.h>
+#include <ATen/NumericUtils.h>
+#include <ATen/OpMathType.h>
+#include <ATen/core/Tensor.h>
+#include <c10/core/ScalarType.h>
+#include <c10/util/complex.h>
+
+#include <ATen/native/xpu/sycl/ScanUtils.h>
+
+namespace at::native::xpu {
+
+// log(exp(x) + exp(y)), computed as max + log1p(exp(min - max)) so that it
+// neither overflows nor loses the smaller term.
+template <typename scalar_t>
+inline scalar_t log_add_exp(scalar_t x, scalar_t y) {
+  scalar_t min = at::_isnan(y) ? y : std::min(x, y);
+  scalar_t max = at::_isnan(y) ? y : std::max(x, y);
+  if (min != max || std::isfinite(min)) {
+    return max + std::log1p(std::exp(min - max));
+  }
+  // Both are the same infinity.
+  return x;
+}
+
+// Complex values are ordered by their real parts.
+template <typename scalar_t, bool is_min>
+inline c10::complex<scalar_t> log_add_exp_minmax(
+    c10::complex<scalar_t> x,
+    c10::complex<scalar_t> y) {
+  if (at::_isnan(y)) {
+    return y;
+  } else if (at::_isnan(x)) {
+    return x;
+  } else if constexpr (is_min) {
+    return x.real() < y.real() ? x : y;
+  } else {
+    return x.real() < y.real() ? y : x;
+  }
+}
+
+template <typename scalar_t>
+inline c10::complex<scalar_t> log_add_exp(
+    c10::complex<scalar_t> x,
+    c10::complex<scalar_t> y) {
+  auto min = log_add_exp_minmax<scalar_t, true>(x, y);
+  auto max = log_add_exp_minmax<scalar_t, false>(x, y);
+  if (at::_isnan(min)) {
+    return {
+        std::numeric_limits<scalar_t>::quiet_NaN(),
+        std::numeric_limits<scalar_t>::quiet_NaN()};
+  } else if (!std::isfinite(min.real()) && min.real() == max.real()) {
+    if (min.real() < 0) {
+      // exp(min) is 0 and its angle is undetermined, so the imaginary part
+      // does not matter.
+      return min;
+    }
+    // Both real parts are +inf, where log1p would produce NaN.
+    return std::log(std::exp(min) + std::exp(max));
+  }
+  return std::log1p(std::exp(min - max)) + max;
+}
+
+template <typename scalar_t>
+struct LogAddExpFunctor {
+  scalar_t operator()(scalar_t a, scalar_t b) const {
+    using opmath_t = at::opmath_type<scalar_t>;
+    return static_cast<scalar_t>(
+        log_add_exp(static_cast<opmath_t>(a), static_cast<opmath_t>(b)));
+  }
+};
+
+void launch_logcumsumexp_kernel(
+    const Tensor& result,
+    const Tensor& self,
+    int64_t dim) {
+  AT_DISPATCH_FLOATING_AND_COMPLEX_TYPES_AND2(
+      ScalarType::Half,
+      ScalarType::BFloat16,
+      self.scalar_type(),
+      "logcumsumexp_xpu",
+      [&]() {
+        // exp(-inf) is 0, the identity of the sum.
+        using value_t = typename c10::scalar_value_type<scalar_t>::type;
+        scalar_t init = -std::numeric_limits<value_t>::infinity();
+        scan<INCLUSIVE_TYPE, scalar_t, scalar_t>(
+            result, self, dim, init, LogAddExpFunctor<scalar_t>());
+      });
+}
+
+} // namespace at::native::xpu
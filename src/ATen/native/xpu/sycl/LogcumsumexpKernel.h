@@ -0,0 +1,12 @@
+#pragma once
+
+#include <ATen/core/TensorBase.h>
+
+namespace at::native::xpu {
+
+void launch_logcumsumexp_kernel(
+    const Tensor& result,
+    const Tensor& self,
+    int64_t dim);
+
+} // namespace at::native::xpu
@@ -43,33 +43,51 @@ inline void elementwise_kernel_helper(func_t f, policy_t policy) {
   policy.store(results);
 }
 
+// Number of tiles of `tile` elements covering `n`. Unlike (n + tile - 1) /
+// tile it does not overflow when n is close to the maximum of index_t.
+template <typename index_t>
+inline index_t tile_count(index_t n, int tile) {
+  return n / tile + (n % tile != 0);
+}
+
+// `index_t` is the type of linear element indices. It is int by default and
+// int64_t when the iterator cannot use 32-bit indexing.
 template <
     typename func_t,
     typename array_t,
     typename in_calc_t,
     typename out_calc_t,
     typename loader_t,
-    typename storer_t>
+    typename storer_t,
+    typename index_t = int>
 struct UnrolledElementwiseKernel {
   static constexpr int item_work_size = 4;
 
   void operator()(sycl::nd_item<1> item) const {
     int grpsz = item.get_local_range(0);
-    int grpid = item.get_group(0);
     int lid = item.get_local_id(0);
-    int remaining = numel_ - item_work_size * grpsz * grpid;
-    auto policy = at::native::memory::policies::unroll<
-        item_work_size,
-        array_t,
-        in_calc_t,
-        out_calc_t,
-        loader_t,
-        storer_t>(data_, remaining, ic_, oc_, l_, s_, lid, grpid, grpsz);
-    elementwise_kernel_helper<item_work_size>(f_, policy);
+    int group_work_size = item_work_size * grpsz;
+    index_t num_tiles = tile_count(numel_, group_work_size);
+    // A group handles one tile in a regular launch and strides over tiles in
+    // a persistent launch, where the grid is capped at device occupancy.
+    for (index_t grpid = item.get_group(0); grpid < num_tiles;
+         grpid += item.get_group_range(0)) {
+      index_t remaining = numel_ - group_work_size * grpid;
+      auto policy = at::native::memory::policies::unroll<
+          item_work_size,
+          array_t,
+          in_calc_t,
+          out_calc_t,
+          loader_t,
+          storer_t,
+          1,
+          index_t>(data_, remaining, ic_, oc_, l_, s_, lid, grpid, grpsz);
+      elementwise_kernel_helper<item_work_size>(f_, policy);
+    }
   };
 
   UnrolledElementwiseKernel(
-      int numel,
+      index_t numel,
       func_t f,
       array_t data,
       in_calc_t ic,
@@ -79,7 +97,7 @@ struct UnrolledElementwiseKernel {
       : numel_(numel), f_(f), data_(data), ic_(ic), oc_(oc), l_(l), s_(s) {}
 
  private:
-  int numel_;
+  index_t numel_;
   func_t f_;
   array_t data_;
   in_calc_t ic_;
@@ -88,46 +106,56 @@ struct UnrolledElementwiseKernel {
   storer_t s_;
 };
 
-template <int vec_size, typename func_t, typename array_t, typename in_calc_t>
+template <
+    int vec_size,
+    typename func_t,
+    typename array_t,
+    typename in_calc_t,
+    typename index_t = int>
 struct VectorizedElementwiseKernel {
   void operator()(sycl::nd_item<1> item) const {
     int grpsz = item.get_local_range(0);
-    int grpid = item.get_group(0);
     int lid = item.get_local_id(0);
     int group_work_size = vec_size * grpsz;
-    int remaining = numel_ - grpid * group_work_size;
-
-    // ic_
-    if (remaining < group_work_size) {
-      auto oc = TrivialOffsetCalculator<1>();
-      auto l = at::native::memory::LoadWithoutCast();
-      auto s = at::native::memory::StoreWithoutCast();
-      auto policy = at::native::memory::policies::unroll<
-          vec_size,
-          array_t,
-          decltype(ic_),
-          decltype(oc),
-          at::native::memory::LoadWithoutCast,
-          at::native::memory::StoreWithoutCast>(
-          data_, remaining, ic_, oc, l, s, lid, grpid, grpsz);
-      elementwise_kernel_helper<vec_size>(f_, policy);
-    } else {
-      auto policy = at::native::memory::policies::
-          vectorized<vec_size, array_t, in_calc_t>(
-              data_, ic_, lid, grpid, grpsz);
-      elementwise_kernel_helper<vec_size>(f_, policy);
+    index_t num_tiles = tile_count(numel_, group_work_size);
+
+    for (index_t grpid = item.get_group(0); grpid < num_tiles;
+         grpid += item.get_group_range(0)) {
+      index_t remaining = numel_ - grpid * group_work_size;
+
+      // ic_
+      if (remaining < group_work_size) {
+        auto oc = TrivialOffsetCalculator<1, std::make_unsigned_t<index_t>>();
+        auto l = at::native::memory::LoadWithoutCast();
+        auto s = at::native::memory::StoreWithoutCast();
+        auto policy = at::native::memory::policies::unroll<
+            vec_size,
+            array_t,
+            decltype(ic_),
+            decltype(oc),
+            at::native::memory::LoadWithoutCast,
+            at::native::memory::StoreWithoutCast,
+            1,
+            index_t>(data_, remaining, ic_, oc, l, s, lid, grpid, grpsz);
+        elementwise_kernel_helper<vec_size>(f_, policy);
+      } else {
+        auto policy = at::native::memory::policies::
+            vectorized<vec_size, array_t, in_calc_t, index_t>(
+                data_, ic_, lid, grpid, grpsz);
+        elementwise_kernel_helper<vec_size>(f_, policy);
+      }
     }
   }
 
   VectorizedElementwiseKernel(
-      int numel,
+      index_t numel,
       const func_t f,
       array_t data,
       in_calc_t ic)
       : numel_(numel), f_(f), data_(data), ic_(ic) {}
 
  private:
-  int numel_;
+  index_t numel_;
   const func_t f_;
   array_t data_;
   in_calc_t ic_;
@@ -144,16 +172,20 @@ struct UnrolledElementwiseForMultiOutputsKernel {
 
   void operator()(sycl::nd_item<1> item_id) const {
     int grpsz = item_id.get_local_range(0);
-    int grpid = item_id.get_group(0);
     int lid = item_id.get_local_id(0);
-    int remaining = numel_ - item_work_size * grpsz * grpid;
-    auto policy = at::native::memory::policies::multi_outputs_unroll<
-        item_work_size,
-        array_t,
-        in_calc_t,
-        out_calc_t,
-        num_outputs>(data_, remaining, ic_, oc_, lid, grpid, grpsz);
-    elementwise_kernel_helper<item_work_size>(f_, policy);
+    int group_work_size = item_work_size * grpsz;
+    int num_tiles = tile_count(numel_, group_work_size);
+    for (int grpid = item_id.get_group(0); grpid < num_tiles;
+         grpid += item_id.get_group_range(0)) {
+      int remaining = numel_ - group_work_size * grpid;
+      auto policy = at::native::memory::policies::multi_outputs_unroll<
+          item_work_size,
+          array_t,
+          in_calc_t,
+          out_calc_t,
+          num_outputs>(data_, remaining, ic_, oc_, lid, grpid, grpsz);
+      elementwise_kernel_helper<item_work_size>(f_, policy);
+    }
   };
 
   UnrolledElementwiseForMultiOutputsKernel(
@@ -216,12 +248,17 @@ struct ElementwiseGroupRangeKernel {
   void operator()(sycl::nd_item<1> item) const {
     int wg_sz = item.get_local_range(0);
     int group_work_size = wg_sz * vec_size;
-    int idx = group_work_size * item.get_group(0) + item.get_local_id(0);
+    int num_tiles = tile_count(numel_, group_work_size);
+    for (int grpid = item.get_group(0); grpid < num_tiles;
+         grpid += item.get_group_range(0)) {
+      int64_t idx = static_cast<int64_t>(group_work_size) * grpid +
+          item.get_local_id(0);
 #pragma unroll
-    for (int i = 0; i < vec_size; i++) {
-      if (idx < numel_) {
-        f_(idx);
-        idx += wg_sz;
+      for (int i = 0; i < vec_size; i++) {
+        if (idx < numel_) {
+          f_(static_cast<int>(idx));
+          idx += wg_sz;
+        }
       }
     }
   };
@@ -236,12 +273,12 @@ struct ElementwiseGroupRangeKernel {
 template <typename func_t>
 struct ElementwiseGlobalRangeKernel {
   void operator()(sycl::nd_item<1> item) const {
-    int linear_idx =
+    int64_t linear_idx =
         item.get_group(0) * item.get_local_range(0) + item.get_local_id(0);
-    for (int idx = linear_idx; idx < numel_;
+    for (int64_t idx = linear_idx; idx < numel_;
          idx += item.get_group_range(0) * item.get_local_range(0)) {
       if (idx < numel_) {
-        f_(idx);
+        f_(static_cast<int>(idx));
       }
     }
   };
@@ -305,8 +342,30 @@ struct LegacyKernelWithCastScalarFunctor {
   const func_t f_;
 };
 
+// Number of work-groups to cover N elements when each group processes
+// group_work_size elements per tile. In persistent mode the grid is capped at
+// the number of work-groups the device keeps resident at once, and each group
+// strides over the remaining tiles. It saves group dispatch and shrinks the
+// tail for very large element counts.
+static inline int64_t elementwise_num_wg(
+    int64_t N,
+    int wg_sz,
+    int group_work_size,
+    bool persistent) {
+  int64_t num_wg = ceil_div<int64_t>(N, group_work_size);
+  if (persistent) {
+    int64_t hw_max_num_wg =
+        std::max<int64_t>(syclMaxWorkItemsPerTile() / wg_sz, 1);
+    num_wg = num_wg > hw_max_num_wg ? hw_max_num_wg : num_wg;
+  }
+  return num_wg;
+}
+
 template <int vec_size, typename func_t>
-static void launch_legacy_group_range_kernel(int64_t N, const func_t& f) {
+static void launch_legacy_group_range_kernel(
+    int64_t N,
+    const func_t& f,
+    bool persistent = false) {
   TORCH_INTERNAL_ASSERT(N >= 0 && N <= std::numeric_limits<int32_t>::max());
   if (N == 0) {
     return;
@@ -315,7 +374,7 @@ static void launch_legacy_group_range_kernel(int64_t N, const func_t& f) {
   auto ker = ElementwiseGroupRangeKernel<vec_size, func_t>(N, f);
 
   int wg_sz = syclMaxWorkItemsPerEU();
-  int num_wg = ceil_div<int>(N, wg_sz * vec_size);
+  int64_t num_wg = elementwise_num_wg(N, wg_sz, wg_sz * vec_size, persistent);
   sycl_kernel_submit(wg_sz * num_wg, wg_sz, getCurrentSYCLQueue(), ker);
 }
 
@@ -336,6 +395,7 @@ static void launch_legacy_global_range_kernel(int64_t N, const func_t& f) {
 }
 
 template <
+    typename index_t = int,
     typename func_t,
     typename array_t,
     typename in_calc_t,
@@ -349,14 +409,23 @@ static inline void launch_unrolled_kernel(
     in_calc_t ic,
     out_calc_t oc,
     loader_t l,
-    storer_t s) {
-  TORCH_INTERNAL_ASSERT(N > 0 && N <= std::numeric_limits<int32_t>::max());
+    storer_t s,
+    bool persistent = false) {
+  TORCH_INTERNAL_ASSERT(N > 0 && N <= std::numeric_limits<index_t>::max());
 
-  auto ker = UnrolledElementwiseKernel(N, f, data, ic, oc, l, s);
+  auto ker = UnrolledElementwiseKernel<
+      func_t,
+      array_t,
+      in_calc_t,
+      out_calc_t,
+      loader_t,
+      storer_t,
+      index_t>(N, f, data, ic, oc, l, s);
   using ker_t = decltype(ker);
 
   auto wg_sz = syclMaxWorkItemsPerEU();
-  int num_wg = ceil_div<int>(N, wg_sz * ker_t::item_work_size);
+  int64_t num_wg =
+      elementwise_num_wg(N, wg_sz, wg_sz * ker_t::item_work_size, persistent);
   sycl_kernel_submit(wg_sz * num_wg, wg_sz, getCurrentSYCLQueue(), ker);
 }
 
@@ -379,28 +448,38 @@ constexpr static inline int max_scalar_size() {
   return std::max<int>(sizeof(return_t), size);
 }
 
-template <typename func_t, typename array_t, typename in_calc_t>
+template <
+    typename index_t = int,
+    typename func_t,
+    typename array_t,
+    typename in_calc_t>
 static inline void launch_vectorized_kernel(
     int64_t N,
     const func_t& f,
     array_t data,
     in_calc_t input_calc,
-    int vec_size) {
+    int vec_size,
+    bool persistent = false) {
   constexpr auto max_scalar_bytes = max_scalar_size<func_t>();
-  TORCH_INTERNAL_ASSERT(N > 0 && N <= std::numeric_limits<int32_t>::max());
+  TORCH_INTERNAL_ASSERT(N > 0 && N <= std::numeric_limits<index_t>::max());
   using traits = function_traits<func_t>;
+  using offset_t = std::make_unsigned_t<index_t>;
   auto wg_sz = syclMaxWorkItemsPerEU();
 
-#define VEC_KER(vec_size)                                                    \
-  {                                                                          \
-    TORCH_CHECK(max_scalar_bytes* vec_size <= 16);                           \
-    if constexpr (max_scalar_bytes * vec_size <= 16) {                       \
-      auto ker =                                                             \
-          VectorizedElementwiseKernel<vec_size, func_t, array_t, in_calc_t>( \
-              N, f, data, input_calc);                                       \
-      int num_wg = ceil_div<int>(N, wg_sz * vec_size);                       \
-      sycl_kernel_submit(wg_sz* num_wg, wg_sz, getCurrentSYCLQueue(), ker);  \
-    }                                                                        \
+#define VEC_KER(vec_size)                                                     \
+  {                                                                           \
+    TORCH_CHECK(max_scalar_bytes* vec_size <= 16);                            \
+    if constexpr (max_scalar_bytes * vec_size <= 16) {                        \
+      auto ker = VectorizedElementwiseKernel<                                 \
+          vec_size,                                                           \
+          func_t,                                                             \
+          array_t,                                                            \
+          in_calc_t,                                                          \
+          index_t>(N, f, data, input_calc);                                   \
+      int64_t num_wg =                                                        \
+          elementwise_num_wg(N, wg_sz, wg_sz * vec_size, persistent);         \
+      sycl_kernel_submit(wg_sz* num_wg, wg_sz, getCurrentSYCLQueue(), ker);   \
+    }                                                                         \
   }
 
   switch (vec_size) {
@@ -417,16 +496,23 @@ static inline void launch_vectorized_kernel(
       VEC_KER(2);
       break;
     case 1: {
-      auto input_calc = TrivialOffsetCalculator<traits::arity>();
-      auto output_calc = TrivialOffsetCalculator<1>();
+      auto input_calc = TrivialOffsetCalculator<traits::arity, offset_t>();
+      auto output_calc = TrivialOffsetCalculator<1, offset_t>();
       auto loader = memory::LoadWithoutCast();
       auto storer = memory::StoreWithoutCast();
 
-      auto ker = UnrolledElementwiseKernel(
-          N, f, data, input_calc, output_calc, loader, storer);
+      auto ker = UnrolledElementwiseKernel<
+          func_t,
+          array_t,
+          decltype(input_calc),
+          decltype(output_calc),
+          decltype(loader),
+          decltype(storer),
+          index_t>(N, f, data, input_calc, output_calc, loader, storer);
       using ker_t = decltype(ker);
 
-      int num_wg = ceil_div<int>(N, wg_sz * ker_t::item_work_size);
+      int64_t num_wg = elementwise_num_wg(
+          N, wg_sz, wg_sz * ker_t::item_work_size, persistent);
       sycl_kernel_submit(wg_sz * num_wg, wg_sz, getCurrentSYCLQueue(), ker);
       break;
     }
@@ -446,7 +532,8 @@ static inline void launch_unrolled_kernel_for_multi_outputs(
     const func_t& f,
     array_t data,
     in_calc_t ic,
-    out_calc_t oc) {
+    out_calc_t oc,
+    bool persistent = false) {
   TORCH_INTERNAL_ASSERT(N > 0 && N <= std::numeric_limits<int32_t>::max());
 
   auto ker = UnrolledElementwiseForMultiOutputsKernel<
@@ -458,7 +545,8 @@ static inline void launch_unrolled_kernel_for_multi_outputs(
   using ker_t = decltype(ker);
 
   int wg_sz = syclMaxWorkItemsPerEU();
-  int num_wg = ceil_div<int>(N, ker_t::item_work_size * wg_sz);
+  int64_t num_wg =
+      elementwise_num_wg(N, wg_sz, ker_t::item_work_size * wg_sz, persistent);
   sycl_kernel_submit(wg_sz * num_wg, wg_sz, getCurrentSYCLQueue(), ker);
 }
 
@@ -496,7 +584,10 @@ static inline bool can_vectorize_for_non_contigouous(
 }
 
 template <typename func_t, bool enable_broadcast_vec>
-void gpu_kernel_impl_nocast(TensorIteratorBase& iter, const func_t& f) {
+void gpu_kernel_impl_nocast(
+    TensorIteratorBase& iter,
+    const func_t& f,
+    bool persistent = false) {
   using traits = function_traits<func_t>;
   using arg0_t = typename traits::result_type;
   constexpr int ntensors = traits::arity + 1;
@@ -520,14 +611,15 @@ void gpu_kernel_impl_nocast(TensorIteratorBase& iter, const func_t& f) {
   if (contiguous) {
     auto input_calc = TrivialOffsetCalculator<traits::arity>();
     vec_size = memory::can_vectorize_up_to<func_t>(data);
-    launch_vectorized_kernel(numel, f, data, input_calc, vec_size);
+    launch_vectorized_kernel(numel, f, data, input_calc, vec_size, persistent);
     return;
   } else {
     if constexpr (enable_broadcast_vec) {
       if (!latency_case &&
           can_vectorize_for_non_contigouous<func_t>(iter, data, vec_size)) {
         auto input_calc = make_input_offset_calculator<traits::arity>(iter);
-        launch_vectorized_kernel(numel, f, data, input_calc, vec_size);
+        launch_vectorized_kernel(
+            numel, f, data, input_calc, vec_size, persistent);
         return;
       }
     }
@@ -544,9 +636,13 @@ void gpu_kernel_impl_nocast(TensorIteratorBase& iter, const func_t& f) {
 }
 
 template <typename func_t, bool enable_broadcast_vec = true>
-void gpu_kernel_impl(TensorIteratorBase& iter, const func_t& f) {
+void gpu_kernel_impl(
+    TensorIteratorBase& iter,
+    const func_t& f,
+    bool persistent = false) {
   if (!needs_dynamic_casting<func_t>::check(iter)) {
-    return gpu_kernel_impl_nocast<func_t, enable_broadcast_vec>(iter, f);
+    return gpu_kernel_impl_nocast<func_t, enable_broadcast_vec>(
+        iter, f, persistent);
   }
   using traits = function_traits<func_t>;
   using arg0_t = typename traits::result_type;
@@ -577,7 +673,8 @@ void gpu_kernel_impl(TensorIteratorBase& iter, const func_t& f) {
         input_offset_calculator,
         output_offset_calculator,
         loader,
-        storer);
+        storer,
+        persistent);
   } else {
     at::detail::Array<ScalarType, ntensors> dtypes;
     for (int i = 0; i < ntensors; i++) {
@@ -591,12 +688,88 @@ void gpu_kernel_impl(TensorIteratorBase& iter, const func_t& f) {
             arg0_t,
             ntensors,
             decltype(offset_calc),
-            func_t>(data, dtypes, offset_calc, f));
+            func_t>(data, dtypes, offset_calc, f),
+        persistent);
+  }
+}
+
+template <
+    typename func_t,
+    typename array_t,
+    typename loader_t,
+    typename storer_t>
+static inline void launch_unrolled_kernel_64bit(
+    TensorIteratorBase& iter,
+    const func_t& f,
+    array_t data,
+    loader_t l,
+    storer_t s) {
+  using traits = function_traits<func_t>;
+  int64_t numel = iter.numel();
+  // Always persistent, see gpu_kernel_impl_64bit.
+  if (iter.is_contiguous()) {
+    auto ic = TrivialOffsetCalculator<traits::arity, uint64_t>();
+    auto oc = TrivialOffsetCalculator<1, uint64_t>();
+    launch_unrolled_kernel<int64_t>(
+        numel, f, data, ic, oc, l, s, /*persistent=*/true);
+  } else {
+    auto ic = make_input_offset_calculator<traits::arity, uint64_t>(iter);
+    auto oc = make_output_offset_calculator<1, uint64_t>(iter);
+    launch_unrolled_kernel<int64_t>(
+        numel, f, data, ic, oc, l, s, /*persistent=*/true);
   }
 }
 
+// Launches the whole iterator once with 64-bit indices, used when it
+// cannot use 32-bit indexing. Splitting with `with_32bit_indexing` costs one
+// TensorIterator setup and one kernel submission per sub-iterator.
+//
+// The launch is always persistent, whatever the caller asked for: the grid
+// is capped at one device-resident wave, which keeps the global range within
+// what SYCL id queries can address (they may be compiled to fit in int)
+// however large numel is. At these sizes the cap costs nothing anyway.
 template <typename func_t>
-void gpu_kernel_nocast(TensorIteratorBase& iter, const func_t& f) {
+void gpu_kernel_impl_64bit(TensorIteratorBase& iter, const func_t& f) {
+  using traits = function_traits<func_t>;
+  constexpr int ntensors = traits::arity + 1;
+
+  TORCH_INTERNAL_ASSERT(iter.ninputs() == traits::arity);
+  TORCH_INTERNAL_ASSERT(iter.noutputs() == 1);
+
+  at::detail::Array<char*, ntensors> data;
+  for (int i = 0; i < ntensors; i++) {
+    data[i] = (char*)iter.data_ptr(i);
+  }
+
+  if (needs_dynamic_casting<func_t>::check(iter)) {
+    auto loader = memory::LoadWithCast<traits::arity>(iter);
+    auto storer = memory::StoreWithCast<1>(iter);
+    launch_unrolled_kernel_64bit(iter, f, data, loader, storer);
+    return;
+  }
+
+  if (iter.is_contiguous()) {
+    auto input_calc = TrivialOffsetCalculator<traits::arity, uint64_t>();
+    int vec_size = memory::can_vectorize_up_to<func_t>(data);
+    launch_vectorized_kernel<int64_t>(
+        iter.numel(), f, data, input_calc, vec_size, /*persistent=*/true);
+    return;
+  }
+
+  auto loader = memory::LoadWithoutCast();
+  auto storer = memory::StoreWithoutCast();
+  launch_unrolled_kernel_64bit(iter, f, data, loader, storer);
+}
+
+// Setting `persistent` launches at most one device-resident wave of
+// work-groups, each looping over tiles, instead of one group per tile. Worth
+// it for large bandwidth-bound pointwise ops, e.g. AMP casts. Iterators that
+// need 64-bit indexing are always launched persistent.
+template <typename func_t>
+void gpu_kernel_nocast(
+    TensorIteratorBase& iter,
+    const func_t& f,
+    bool persistent = false) {
   for (int arg = 0; arg < iter.ntensors(); arg++) {
     TORCH_INTERNAL_ASSERT(
         iter.device(arg).is_xpu(),
@@ -611,17 +784,18 @@ void gpu_kernel_nocast(TensorIteratorBase& iter, const func_t& f) {
   }
 
   if (!iter.can_use_32bit_indexing()) {
-    for (auto& sub_iter : iter.with_32bit_indexing()) {
-      gpu_kernel_nocast(sub_iter, f);
-    }
+    gpu_kernel_impl_64bit(iter, f);
     return;
   }
 
-  gpu_kernel_impl_nocast(iter, f);
+  gpu_kernel_impl_nocast<func_t, true>(iter, f, persistent);
 }
 
 template <typename func_t>
-void gpu_kernel(TensorIteratorBase& iter, const func_t& f) {
+void gpu_kernel(
+    TensorIteratorBase& iter,
+    const func_t& f,
+    bool persistent = false) {
   for (int arg = 0; arg < iter.ntensors(); arg++) {
     TORCH_INTERNAL_ASSERT(
         iter.device(arg).is_xpu(),
@@ -636,13 +810,11 @@ void gpu_kernel(TensorIteratorBase& iter, const func_t& f) {
   }
 
   if (!iter.can_use_32bit_indexing()) {
-    for (auto& sub_iter : iter.with_32bit_indexing()) {
-      gpu_kernel(sub_iter, f);
-    }
+    gpu_kernel_impl_64bit(iter, f);
     return;
   }
 
-  gpu_kernel_impl(iter, f);
+  gpu_kernel_impl(iter, f, persistent);
 }
 
 template <typename arg1_t, typename arg2_t, typename return_t, typename func_t>
@@ -770,7 +942,8 @@ void gpu_kernel_with_scalars(TensorIteratorBase& iter, const func_t& f) {
 template <typename func_t>
 void gpu_kernel_multiple_outputs_impl(
     TensorIteratorBase& iter,
-    const func_t& f) {
+    const func_t& f,
+    bool persistent = false) {
   using traits = function_traits<func_t>;
   using output_t = typename traits::result_type;
   constexpr int num_outputs = std::tuple_size<output_t>::value;
@@ -791,17 +964,20 @@ void gpu_kernel_multiple_outputs_impl(
     auto input_calc = TrivialOffsetCalculator<num_inputs>();
     auto output_calc = TrivialOffsetCalculator<num_outputs>();
     launch_unrolled_kernel_for_multi_outputs<num_outputs>(
-        numel, f, data, input_calc, output_calc);
+        numel, f, data, input_calc, output_calc, persistent);
   } else {
     auto input_calc = make_input_offset_calculator<num_inputs>(iter);
     auto output_calc = make_output_offset_calculator<num_outputs>(iter);
     launch_unrolled_kernel_for_multi_outputs<num_outputs>(
-        numel, f, data, input_calc, output_calc);
+        numel, f, data, input_calc, output_calc, persistent);
   }
 }
 
 template <typename func_t>
-void gpu_kernel_multiple_outputs(TensorIteratorBase& iter, const func_t& f) {
+void gpu_kernel_multiple_outputs(
+    TensorIteratorBase& iter,
+    const func_t& f,
+    bool persistent = false) {
   for (int arg = 0; arg < iter.ntensors(); arg++) {
     TORCH_INTERNAL_ASSERT(iter.device(arg).is_xpu());
   }
@@ -812,12 +988,12 @@ void gpu_kernel_multiple_outputs(TensorIteratorBase& iter, const func_t& f) {
 
   if (!iter.can_use_32bit_indexing()) {
     for (auto& sub_iter : iter.with_32bit_indexing()) {
-      gpu_kernel_multiple_outputs(sub_iter, f);
+      gpu_kernel_multiple_outputs(sub_iter, f, persistent);
     }
     return;
   }
 
-  gpu_kernel_multiple_outputs_impl(iter, f);
+  gpu_kernel_multiple_outputs_impl(iter, f, persistent);
 }
 
 } // namespace xpu
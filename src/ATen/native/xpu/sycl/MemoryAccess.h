@@ -20,6 +20,8 @@ namespace policies {
 
 // Assumption:
 // all tensors are contiguous, that is: stride == sizeof(type) for all tensors
+// `index_t` is the type of linear element indices, int64_t for launches
+// exceeding 32-bit indexing.
 template <
     int item_work_size,
     typename data_t,
@@ -27,28 +29,29 @@ template <
     typename out_calc_t,
     typename loader_t,
     typename storer_t,
-    int num_outputs = 1>
+    int num_outputs = 1,
+    typename index_t = int>
 struct unroll {
   data_t data;
-  int remaining;
+  index_t remaining;
   inp_calc_t input_offset_calculator;
   out_calc_t output_offset_calculator;
   loader_t loader;
   storer_t storer;
   int item_idx;
-  int group_idx;
+  index_t group_idx;
   int num_items_per_group;
   int group_work_size;
 
   unroll(
       data_t data,
-      int remaining,
+      index_t remaining,
       inp_calc_t ic,
       out_calc_t oc,
       loader_t l,
       storer_t s,
       int item_idx,
-      int group_idx,
+      index_t group_idx,
       int num_items_per_group)
       : data(data),
         remaining(remaining),
@@ -74,7 +77,7 @@ struct unroll {
       if (item_idx_ >= remaining) {
         return;
       }
-      int linear_idx = item_idx_ + group_work_size * group_idx;
+      index_t linear_idx = item_idx_ + group_work_size * group_idx;
       auto offset = input_offset_calculator.get(linear_idx);
       detail::static_unroll<detail::unroll_load_helper, arity>::with_args(
           *this, args, offset, loader, i, num_outputs);
@@ -90,8 +93,8 @@ struct unroll {
       if (item_idx_ >= remaining) {
         return;
       }
-      int linear_idx = item_idx_ + group_work_size * group_idx;
-      int offset = output_offset_calculator.get(linear_idx)[0];
+      index_t linear_idx = item_idx_ + group_work_size * group_idx;
+      auto offset = output_offset_calculator.get(linear_idx)[0];
       storer.store(from[i], data[0], offset);
       item_idx_ += num_items_per_group;
     }
@@ -101,12 +104,16 @@ struct unroll {
 // Assumption:
 // 1. tensors could be contiguous, that is: stride == sizeof(type).
 // 2. tensors could be broadcasted.
-template <int vec_size, typename data_t, typename inp_calc_t>
+template <
+    int vec_size,
+    typename data_t,
+    typename inp_calc_t,
+    typename index_t = int>
 struct vectorized {
   data_t data;
   inp_calc_t input_offset_calculator;
   int item_idx;
-  int group_idx;
+  index_t group_idx;
   int num_items_per_group;
   int group_work_size;
 
@@ -114,7 +121,7 @@ struct vectorized {
       data_t data,
       inp_calc_t ic,
       int item_idx,
-      int group_idx,
+      index_t group_idx,
       int num_items_per_group)
       : data(data),
         input_offset_calculator(ic),
@@ -139,7 +146,7 @@ struct vectorized {
   template <typename args_t>
   inline void load(args_t* args) {
     constexpr int arity = std::tuple_size<args_t>::value;
-    int group_offset = group_work_size * group_idx;
+    index_t group_offset = group_work_size * group_idx;
     // `Unroll` policy cannot feed memory bandwidth well on Intel GPU,
     // 1. Small loop size cannot provide enough payloads, specially for small
     //    size data type s8/u8/f16/bf16.
@@ -99,8 +99,8 @@ struct multi_outputs_store_helper {
 } // namespace detail
 
 struct LoadWithoutCast {
-  template <typename scalar_t>
-  C10_DEVICE scalar_t load(char* base_ptr, uint32_t offset, int arg) {
+  template <typename scalar_t, typename offset_t = uint32_t>
+  C10_DEVICE scalar_t load(char* base_ptr, offset_t offset, int arg) {
     return c10::load(reinterpret_cast<scalar_t*>(base_ptr) + offset);
   }
 };
@@ -122,19 +122,19 @@ struct LoadWithCast {
     }
   }
 
-  template <typename scalar_t>
-  C10_DEVICE scalar_t load(char* base_ptr, uint32_t offset, int arg) {
+  template <typename scalar_t, typename offset_t = uint32_t>
+  C10_DEVICE scalar_t load(char* base_ptr, offset_t offset, int arg) {
     void* ptr = base_ptr + element_sizes[arg] * offset;
     return c10::fetch_and_cast<scalar_t>(dtypes[arg], ptr);
   }
 };
 
 struct StoreWithoutCast {
-  template <typename scalar_t>
+  template <typename scalar_t, typename offset_t = uint32_t>
   C10_DEVICE void store(
       scalar_t value,
       char* base_ptr,
-      uint32_t offset,
+      offset_t offset,
       int arg = 0) {
     *(reinterpret_cast<scalar_t*>(base_ptr) + offset) = value;
   }
@@ -157,11 +157,11 @@ struct StoreWithCast {
     }
   }
 
-  template <typename scalar_t>
+  template <typename scalar_t, typename offset_t = uint32_t>
   C10_DEVICE void store(
       scalar_t value,
       char* base_ptr,
-      uint32_t offset,
+      offset_t offset,
       int arg = 0) {
     void* ptr = base_ptr + element_sizes[arg] * offset;
     c10::cast_and_store<scalar_t>(dtypes[arg], ptr, value);
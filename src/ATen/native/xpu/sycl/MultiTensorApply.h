@@ -48,6 +48,41 @@ struct TLMetaForWG {
   uint32_t wg_to_chunk;
 };
 
+// Metadata passed by value as kernel arguments. A list whose metadata fits in
+// a few launches needs neither device/host staging buffers nor memcpys. The
+// budgets keep the kernel arguments within the 2KB the GPU drivers accept.
+static constexpr int kArgsAddressMetaBytes = 768;
+static constexpr int kArgsWGMetaBytes = 768;
+// Lists that would need more launches use device-resident metadata.
+static constexpr int kMaxArgsLaunches = 8;
+
+// Holds the address metadata of tensors [start_tensor, start_tensor + n). It
+// is indexed with the absolute tensor index, so callables can use the same
+// indexing as with device-resident metadata.
+template <typename addr_meta_t>
+struct TLMetaForAddressArgs {
+  static constexpr int kMaxTensors =
+      kArgsAddressMetaBytes / sizeof(addr_meta_t);
+  static_assert(kMaxTensors > 0, "Address metadata is too large");
+
+  const addr_meta_t& operator[](uint32_t tensor_loc) const {
+    return meta[tensor_loc - start_tensor];
+  }
+
+  addr_meta_t meta[kMaxTensors];
+  uint32_t start_tensor;
+};
+
+struct TLMetaForWGArgs {
+  static constexpr int kMaxWGs = kArgsWGMetaBytes / sizeof(TLMetaForWG);
+
+  const TLMetaForWG& operator[](size_t wg) const {
+    return meta[wg];
+  }
+
+  TLMetaForWG meta[kMaxWGs];
+};
+
 template <class KernelClass>
 static int64_t multi_tensor_apply_kernel_get_wg_size() {
   return syclMaxWorkGroupSize<KernelClass>();
@@ -138,6 +173,90 @@ void launch_multi_tensor_apply_kernel(
       kfn);
 }
 
+// Launches the callable with all metadata in kernel arguments, splitting the
+// list over several launches when it does not fit in one. A tensor whose
+// chunks span two launches is recorded in both. Returns false without
+// launching anything if the list would need more than kMaxArgsLaunches.
+template <
+    bool fused_kernel,
+    typename addr_meta_t,
+    typename fill_t,
+    typename U,
+    typename... ArgTypes>
+bool multi_tensor_apply_with_kernel_args(
+    const std::vector<at::Tensor>& tensors,
+    fill_t fill_address_meta,
+    U callable,
+    ArgTypes... args) {
+  using TLA = TLMetaForAddressArgs<addr_meta_t>;
+  using TLW = TLMetaForWGArgs;
+  using KernelClass = MultiTensorApplyKernelFunctor<TLA, TLW, U, ArgTypes...>;
+
+  int64_t kChunkSize;
+  if constexpr (fused_kernel) {
+    kChunkSize = multi_tensor_apply_fused_kernel_get_chunk_size();
+  } else {
+    kChunkSize = multi_tensor_apply_kernel_get_chunk_size<KernelClass>();
+  }
+
+  const size_t n_tensors = tensors.size();
+  uint64_t totalWG = 0;
+  for (size_t t = 0; t < n_tensors; ++t) {
+    totalWG += (tensors[t].numel() + kChunkSize - 1) / kChunkSize;
+  }
+  // Upper bound of launches, each launch is cut by whichever budget runs out
+  // first.
+  uint64_t num_launches =
+      (n_tensors + TLA::kMaxTensors - 1) / TLA::kMaxTensors +
+      (totalWG + TLW::kMaxWGs - 1) / TLW::kMaxWGs;
+  if (num_launches > kMaxArgsLaunches) {
+    return false;
+  }
+
+  TLA tlAddress;
+  TLW tlWGMeta;
+  tlAddress.start_tensor = 0;
+  int n_tl = 0;
+  int n_wg = 0;
+  for (size_t t = 0; t < n_tensors; ++t) {
+    fill_address_meta(tlAddress.meta[n_tl++], t);
+    auto chunkForWG = (tensors[t].numel() + kChunkSize - 1) / kChunkSize;
+    for (int64_t chunkId = 0; chunkId < chunkForWG; ++chunkId) {
+      tlWGMeta.meta[n_wg].wg_to_tensor = t;
+      tlWGMeta.meta[n_wg].wg_to_chunk = chunkId;
+      if (++n_wg < TLW::kMaxWGs) {
+        continue;
+      }
+      launch_multi_tensor_apply_kernel<fused_kernel>(
+          tlAddress, tlWGMeta, callable, n_wg, args...);
+      n_wg = 0;
+      if (chunkId == chunkForWG - 1) {
+        n_tl = 0;
+        tlAddress.start_tensor = t + 1;
+      } else {
+        // The remaining chunks of tensor t go with the next launch.
+        tlAddress.meta[0] = tlAddress.meta[n_tl - 1];
+        n_tl = 1;
+        tlAddress.start_tensor = t;
+      }
+    }
+    if (n_tl == TLA::kMaxTensors) {
+      if (n_wg > 0) {
+        launch_multi_tensor_apply_kernel<fused_kernel>(
+            tlAddress, tlWGMeta, callable, n_wg, args...);
+      }
+      n_wg = 0;
+      n_tl = 0;
+      tlAddress.start_tensor = t + 1;
+    }
+  }
+  if (n_wg > 0) {
+    launch_multi_tensor_apply_kernel<fused_kernel>(
+        tlAddress, tlWGMeta, callable, n_wg, args...);
+  }
+  return true;
+}
+
 template <int depth, typename scalar_t, typename T, typename... ArgTypes>
 void multi_tensor_apply(
     std::vector<std::vector<at::Tensor>>& tensor_lists,
@@ -156,6 +275,22 @@ void multi_tensor_apply(
       "Number of tensor lists has to match he depth");
   size_t n_tensors = tensor_lists[0].size();
 
+  if (multi_tensor_apply_with_kernel_args<
+          false,
+          TLMetaForAddressScalar<scalar_vals_t, depth>>(
+          tensor_lists[0],
+          [&](TLMetaForAddressScalar<scalar_vals_t, depth>& meta, size_t t) {
+            meta.numel_to_tensor = tensor_lists[0][t].numel();
+            meta.scalar_vals = scalars[t].to<scalar_t>();
+            for (int d = 0; d < depth; ++d) {
+              meta.addresses[d] = tensor_lists[d][t].mutable_data_ptr();
+            }
+          },
+          callable,
+          args...)) {
+    return;
+  }
+
   auto& q = getCurrentSYCLQueue();
   int64_t kChunkSize = multi_tensor_apply_kernel_get_chunk_size<KernelClass>();
 
@@ -242,6 +377,19 @@ void multi_tensor_apply(
       "Number of tensor lists has to match he depth");
   size_t n_tensors = tensor_lists[0].size();
 
+  if (multi_tensor_apply_with_kernel_args<false, TLMetaForAddress<depth>>(
+          tensor_lists[0],
+          [&](TLMetaForAddress<depth>& meta, size_t t) {
+            meta.numel_to_tensor = tensor_lists[0][t].numel();
+            for (int d = 0; d < depth; ++d) {
+              meta.addresses[d] = tensor_lists[d][t].mutable_data_ptr();
+            }
+          },
+          callable,
+          args...)) {
+    return;
+  }
+
   auto& q = getCurrentSYCLQueue();
   int64_t kChunkSize = multi_tensor_apply_kernel_get_chunk_size<KernelClass>();
 
@@ -320,6 +468,20 @@ void multi_tensor_apply_for_fused_optimizer(
       "Number of tensor lists has to match the depth");
   const auto n_tensors = tensor_lists[0].size();
 
+  if (multi_tensor_apply_with_kernel_args<true, TLFusedMetaForAddress<depth>>(
+          tensor_lists[0],
+          [&](TLFusedMetaForAddress<depth>& meta, size_t t) {
+            meta.numel_to_tensor = tensor_lists[0][t].numel();
+            meta.state_steps_addresses = state_steps[t].mutable_data_ptr();
+            for (int d = 0; d < depth; ++d) {
+              meta.addresses[d] = tensor_lists[d][t].mutable_data_ptr();
+            }
+          },
+          callable,
+          args...)) {
+    return;
+  }
+
   auto& q = getCurrentSYCLQueue();
   int64_t kChunkSize = multi_tensor_apply_fused_kernel_get_chunk_size();
 
@@ -122,8 +122,8 @@ make_element_offset_calculator(const at::TensorIteratorBase& iter) {
       iter.ndim(), iter.shape().data(), strides.data(), element_sizes.data());
 }
 
-template <int N>
-static OffsetCalculator<N> make_input_offset_calculator(
+template <int N, typename index_t = uint32_t>
+static OffsetCalculator<N, index_t> make_input_offset_calculator(
     const at::TensorIteratorBase& iter) {
   // array size can not be 0, this happens when N == 0
   constexpr int array_size = std::max<int>(N, 1);
@@ -134,12 +134,12 @@ static OffsetCalculator<N> make_input_offset_calculator(
     strides[i] = iter.strides(i + iter.noutputs()).data();
     element_sizes[i] = iter.element_size(i + iter.noutputs());
   }
-  return OffsetCalculator<N>(
+  return OffsetCalculator<N, index_t>(
       iter.ndim(), iter.shape().data(), strides.data(), element_sizes);
 }
 
-template <int num_outputs = 1>
-static OffsetCalculator<num_outputs> make_output_offset_calculator(
+template <int num_outputs = 1, typename index_t = uint32_t>
+static OffsetCalculator<num_outputs, index_t> make_output_offset_calculator(
     const at::TensorIteratorBase& iter) {
   TORCH_INTERNAL_ASSERT(num_outputs == iter.noutputs());
   std::array<const int64_t*, num_outputs> strides;
@@ -148,6 +148,6 @@ static OffsetCalculator<num_outputs> make_output_offset_calculator(
     strides[i] = iter.strides(i).data();
     element_sizes[i] = iter.element_size(i);
   }
-  return OffsetCalculator<num_outputs>(
+  return OffsetCalculator<num_outputs, index_t>(
       iter.ndim(), iter.shape().data(), strides.data(), element_sizes);
 }
@@ -0,0 +1,58 @@
+#include <ATen/native/xpu/sycl/Reduce.h>
+#include <c10/xpu/XPUStream.h>
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+namespace at {
+namespace native {
+namespace xpu {
+
+namespace {
+
+struct ReduceWorkspaceCache {
+  std::mutex mutex;
+  std::unordered_map<c10::Stream, std::shared_ptr<ReduceWorkspace>> workspaces;
+};
+
+ReduceWorkspaceCache& reduce_workspace_cache() {
+  // Leaked, so that cached blocks are not returned to the allocator during
+  // static destruction, after the XPU runtime may have been torn down.
+  static auto* cache = new ReduceWorkspaceCache();
+  return *cache;
+}
+
+} // namespace
+
+std::shared_ptr<ReduceWorkspace> get_reduce_workspace(
+    int64_t buffer_size,
+    int64_t semaphore_size) {
+  auto stream = c10::xpu::getCurrentXPUStream();
+  auto& cache = reduce_workspace_cache();
+  std::lock_guard<std::mutex> lock(cache.mutex);
+  auto& workspace = cache.workspaces[stream.unwrap()];
+  if (workspace && workspace->buffer_size >= buffer_size &&
+      workspace->semaphore_size >= semaphore_size) {
+    return workspace;
+  }
+
+  // Reductions still in flight on the stream keep using the old blocks. The
+  // caching allocator hands them out again only to later work on the
+  // stream, so dropping them here is safe.
+  auto grown = std::make_shared<ReduceWorkspace>();
+  grown->buffer_size =
+      std::max(buffer_size, workspace ? workspace->buffer_size : 0);
+  grown->semaphore_size =
+      std::max(semaphore_size, workspace ? workspace->semaphore_size : 0);
+  auto allocator = c10::GetAllocator(kXPU);
+  grown->buffer = allocator->allocate(grown->buffer_size);
+  grown->semaphores = allocator->allocate(grown->semaphore_size);
+  stream.queue().memset(grown->semaphores.get(), 0, grown->semaphore_size);
+  workspace = grown;
+  return workspace;
+}
+
+} // namespace xpu
+} // namespace native
+} // namespace at
@@ -15,6 +15,7 @@
 #include <comm/SYCLContext.h>
 #include <functional>
 #include <iosfwd>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -368,6 +369,24 @@ struct ReduceConfig {
 
 std::ostream& operator<<(std::ostream& out, const ReduceConfig& config);
 
+// Staging buffer and semaphores of global reductions. They are cached per
+// stream, as reductions on a stream run one after another, and grow to the
+// largest request. Semaphores are zeroed once on allocation and reset by the
+// last work-group of each output after use, so a reduction neither allocates
+// nor launches a zeroing kernel.
+struct ReduceWorkspace {
+  at::DataPtr buffer;
+  int64_t buffer_size = 0;
+  at::DataPtr semaphores;
+  int64_t semaphore_size = 0;
+};
+
+// The returned workspace must be kept alive until the reduction is
+// submitted, a larger request on the stream replaces the cached one.
+std::shared_ptr<ReduceWorkspace> get_reduce_workspace(
+    int64_t buffer_size,
+    int64_t semaphore_size);
+
 template <int output_vec_size, typename R>
 class ReduceKernel : public __SYCL_KER_CONFIG_CONVENTION__ {
  public:
@@ -443,6 +462,175 @@ func_wrapper_t<out_scalar_t, func_t> func_wrapper(const func_t& op) {
   return func_wrapper_t<out_scalar_t, func_t>{op};
 }
 
+// At most this many tensors are written by one reduction.
+constexpr int kReduceMaxOutputs = 4;
+
+// Trivially copyable tuple, so that it can be exchanged through sub-group
+// shuffles and local memory like any other accumulator.
+template <typename... Ts>
+struct ReduceTuple;
+
+template <>
+struct ReduceTuple<> {};
+
+template <typename T, typename... Ts>
+struct ReduceTuple<T, Ts...> {
+  T head;
+  ReduceTuple<Ts...> tail;
+};
+
+inline ReduceTuple<> make_reduce_tuple() {
+  return {};
+}
+
+template <typename T, typename... Ts>
+ReduceTuple<T, Ts...> make_reduce_tuple(T head, Ts... tail) {
+  return {head, make_reduce_tuple(tail...)};
+}
+
+template <typename T, typename... Ts>
+ReduceTuple<T, Ts...> reduce_tuple_prepend(T head, ReduceTuple<Ts...> tail) {
+  return {head, tail};
+}
+
+// Number of outputs a projected result is written to, a pair takes two.
+template <typename T>
+struct ReduceResultWidth {
+  static constexpr int value = 1;
+};
+
+template <typename T1, typename T2>
+struct ReduceResultWidth<std::pair<T1, T2>> {
+  static constexpr int value = 2;
+};
+
+template <typename... Ts>
+struct ReduceResultWidth<ReduceTuple<Ts...>> {
+  static constexpr int value = (0 + ... + ReduceResultWidth<Ts>::value);
+};
+
+namespace detail {
+
+template <typename scalar_t, typename index_t>
+inline ReduceTuple<> multi_reduce(
+    const ReduceTuple<>& /*ops*/,
+    ReduceTuple<> acc,
+    scalar_t /*data*/,
+    index_t /*idx*/) {
+  return acc;
+}
+
+template <
+    typename op_t,
+    typename... ops_t,
+    typename acc_t,
+    typename... accs_t,
+    typename scalar_t,
+    typename index_t>
+inline ReduceTuple<acc_t, accs_t...> multi_reduce(
+    const ReduceTuple<op_t, ops_t...>& ops,
+    ReduceTuple<acc_t, accs_t...> acc,
+    scalar_t data,
+    index_t idx) {
+  return {
+      ops.head.reduce(acc.head, data, idx),
+      multi_reduce(ops.tail, acc.tail, data, idx)};
+}
+
+inline ReduceTuple<> multi_combine(
+    const ReduceTuple<>& /*ops*/,
+    ReduceTuple<> a,
+    ReduceTuple<> /*b*/) {
+  return a;
+}
+
+template <
+    typename op_t,
+    typename... ops_t,
+    typename acc_t,
+    typename... accs_t>
+inline ReduceTuple<acc_t, accs_t...> multi_combine(
+    const ReduceTuple<op_t, ops_t...>& ops,
+    ReduceTuple<acc_t, accs_t...> a,
+    ReduceTuple<acc_t, accs_t...> b) {
+  return {
+      ops.head.combine(a.head, b.head),
+      multi_combine(ops.tail, a.tail, b.tail)};
+}
+
+inline ReduceTuple<> multi_translate_idx(
+    const ReduceTuple<>& /*ops*/,
+    ReduceTuple<> acc,
+    int64_t /*base_idx*/) {
+  return acc;
+}
+
+template <
+    typename op_t,
+    typename... ops_t,
+    typename acc_t,
+    typename... accs_t>
+inline ReduceTuple<acc_t, accs_t...> multi_translate_idx(
+    const ReduceTuple<op_t, ops_t...>& ops,
+    ReduceTuple<acc_t, accs_t...> acc,
+    int64_t base_idx) {
+  return {
+      ops.head.translate_idx(acc.head, base_idx),
+      multi_translate_idx(ops.tail, acc.tail, base_idx)};
+}
+
+inline ReduceTuple<> multi_project(
+    const ReduceTuple<>& /*ops*/,
+    ReduceTuple<> /*acc*/) {
+  return {};
+}
+
+template <
+    typename op_t,
+    typename... ops_t,
+    typename acc_t,
+    typename... accs_t>
+inline auto multi_project(
+    const ReduceTuple<op_t, ops_t...>& ops,
+    ReduceTuple<acc_t, accs_t...> acc) {
+  return reduce_tuple_prepend(
+      ops.head.project(acc.head), multi_project(ops.tail, acc.tail));
+}
+
+} // namespace detail
+
+// Runs several reductions over the same input in a single pass, e.g. sum and
+// sum of squares, or statistics of the real and imaginary parts of a complex
+// input, so that the input is read once instead of once per statistic. The
+// accumulator and the result are ReduceTuples of those of the reductions.
+// Results are written to the outputs of the iterator in order, a reduction
+// projecting to a std::pair (e.g. WelfordOps) takes two of them.
+template <typename scalar_t, typename... ops_t>
+struct MultiReduceOps {
+  using acc_t = ReduceTuple<
+      typename binary_function_traits<decltype(&ops_t::combine)>::arg1_t...>;
+
+  ReduceTuple<ops_t...> ops;
+
+  MultiReduceOps(ops_t... reducers) : ops(make_reduce_tuple(reducers...)) {}
+
+  inline acc_t reduce(acc_t acc, scalar_t data, int64_t idx) const {
+    return detail::multi_reduce(ops, acc, data, idx);
+  }
+
+  inline acc_t combine(acc_t a, acc_t b) const {
+    return detail::multi_combine(ops, a, b);
+  }
+
+  inline auto project(acc_t acc) const {
+    return detail::multi_project(ops, acc);
+  }
+
+  inline acc_t translate_idx(acc_t acc, int64_t base_idx) const {
+    return detail::multi_translate_idx(ops, acc, base_idx);
+  }
+};
+
 template <
     typename scalar_t,
     typename ops_t,
@@ -475,7 +663,7 @@ struct ReduceOp {
   InputCalculator input_calc;
   OutputCalculator output_calc;
   const void* src;
-  const char* dst[2]; // it accepts at most two destinations
+  const char* dst[kReduceMaxOutputs];
   // acc_buf used for accumulation among sub Tensor Iterator when accumulation
   // on output is not permissible
   void* acc_buf;
@@ -494,8 +682,7 @@ struct ReduceOp {
       InputCalculator input_calc,
       OutputCalculator output_calc,
       const void* src,
-      char* dst0,
-      c10::optional<char*> dst1,
+      at::detail::Array<char*, kReduceMaxOutputs> dst,
       void* acc_buf,
       void* group_buf,
       int* semaphores,
@@ -513,9 +700,8 @@ struct ReduceOp {
         semaphores(semaphores),
         base_idx(base_idx),
         noutputs(noutputs) {
-    dst[0] = dst0;
-    if (dst1.has_value()) {
-      dst[1] = dst1.value();
+    for (int i = 0; i < kReduceMaxOutputs; i++) {
+      this->dst[i] = dst[i];
     }
   }
 
@@ -969,6 +1155,11 @@ struct ReduceOp {
           1, sycl_mem_odr_acq_rel
           /* , default memory scope is device */);
       finished[0] = (prev_groups_finished == (int)(pos.get_group_range(0) - 1));
+      // All other groups of the output have arrived, so the last one leaves
+      // the semaphore zeroed for the next reduction using the workspace.
+      if (finished[0]) {
+        count.store(0);
+      }
     }
     pos.barrier(sycl_local_fence);
   }
@@ -1041,6 +1232,43 @@ struct ReduceOp {
     }
   }
 
+  template <int i, class T>
+  void set_result_at(const T x, const index_t base_offset) const {
+    if (i < noutputs) {
+      // base offset is computed for the element size of the first output
+      auto res = (T*)((char*)dst[i] + base_offset / sizeof(out_scalar_t) *
+                      sizeof(T));
+      *res = x;
+    }
+  }
+
+  template <int i, class T1, class T2>
+  void set_result_at(const std::pair<T1, T2> x, const index_t base_offset)
+      const {
+    set_result_at<i>(x.first, base_offset);
+    set_result_at<i + 1>(x.second, base_offset);
+  }
+
+  template <int i, class... Ts>
+  void set_result_at(const ReduceTuple<Ts...> x, const index_t base_offset)
+      const {
+    if constexpr (sizeof...(Ts) > 0) {
+      set_result_at<i>(x.head, base_offset);
+      set_result_at<i + ReduceResultWidth<decltype(x.head)>::value>(
+          x.tail, base_offset);
+    }
+  }
+
+  // Results of MultiReduceOps, written to the outputs in order.
+  template <class... Ts>
+  void set_results(const ReduceTuple<Ts...> x, const index_t base_offset)
+      const {
+    static_assert(
+        ReduceResultWidth<ReduceTuple<Ts...>>::value <= kReduceMaxOutputs,
+        "too many outputs of a reduction");
+    set_result_at<0>(x, base_offset);
+  }
+
   template <int output_vec_size>
   void set_results_to_output(
       at::detail::Array<arg_t, output_vec_size> value,
@@ -1267,12 +1495,6 @@ int get_output_vec_size(at::TensorIterator& iter) {
   return std::min(vec_size, vt1);
 }
 
-struct ReduceKernelEmptyFunctor {
-  char operator()() const {
-    return 0;
-  }
-};
-
 template <
     typename scalar_t,
     typename out_scalar_t,
@@ -1336,11 +1558,10 @@ inline void gpu_reduce_kernel(
   char* in_data = (char*)iter.data_ptr(iter.ntensors() - 1);
   char* out_data = (char*)iter.data_ptr(0);
   const auto noutputs = iter.noutputs();
-  c10::optional<char*> out_data_extra;
-  if (noutputs > 1) {
-    out_data_extra = (char*)iter.data_ptr(1);
-  } else {
-    out_data_extra = c10::nullopt;
+  TORCH_INTERNAL_ASSERT(noutputs <= kReduceMaxOutputs);
+  at::detail::Array<char*, kReduceMaxOutputs> out_data_all;
+  for (int i = 0; i < kReduceMaxOutputs; i++) {
+    out_data_all[i] = i < noutputs ? (char*)iter.data_ptr(i) : nullptr;
   }
   char* acc_data = acc_buf_ptr->get_acc_slice(out_data);
 
@@ -1506,21 +1727,10 @@ inline void gpu_reduce_kernel(
     }
   }
 
-  Tensor buffer;
-  Tensor semaphores;
+  std::shared_ptr<ReduceWorkspace> workspace;
   if (config.should_global_reduce()) {
-    // auto allocator = c10::xpu::XPUCachingAllocator::get();
-    buffer = at::empty(
-        config.global_memory_size(),
-        at::TensorOptions().dtype(kChar).device(kXPU));
-    semaphores = at::empty(
-        config.semaphore_size(), at::TensorOptions().dtype(kChar).device(kXPU));
-    at::detail::Array<char*, 1> data;
-    data[0] = (char*)semaphores.data_ptr();
-    ReduceKernelEmptyFunctor fn;
-    int vec_size = at::native::memory::can_vectorize_up_to<decltype(fn)>(data);
-    auto ic = TrivialOffsetCalculator<traits::arity>();
-    launch_vectorized_kernel(config.semaphore_size(), fn, data, ic, vec_size);
+    workspace = get_reduce_workspace(
+        config.global_memory_size(), config.semaphore_size());
   }
 
   AT_ASSERT(can_use_32bit_indexing);
@@ -1532,11 +1742,10 @@ inline void gpu_reduce_kernel(
         input_calc,
         output_calc,
         in_data,
-        out_data,
-        out_data_extra,
+        out_data_all,
         acc_data,
-        buffer.defined() ? (void*)buffer.data_ptr() : nullptr,
-        buffer.defined() ? (int*)semaphores.data_ptr() : nullptr,
+        workspace ? workspace->buffer.get() : nullptr,
+        workspace ? (int*)workspace->semaphores.get() : nullptr,
         ident,
         noutputs,
         base_idx);
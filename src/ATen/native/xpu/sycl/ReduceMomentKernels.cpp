@@ -44,6 +44,52 @@ void std_var_kernel(
   }
 }
 
+// Welford reduction of the real or the imaginary part of a complex input.
+template <typename scalar_t, typename accscalar_t, typename out_t, bool imag>
+struct ComplexPartWelfordOps : public WelfordOps<
+                                   scalar_t,
+                                   accscalar_t,
+                                   int32_t,
+                                   std::pair<out_t, out_t>> {
+  using ops_t =
+      WelfordOps<scalar_t, accscalar_t, int32_t, std::pair<out_t, out_t>>;
+  using acc_t = typename ops_t::acc_t;
+
+  inline acc_t reduce(acc_t acc, c10::complex<scalar_t> data, int64_t idx)
+      const {
+    return ops_t::reduce(acc, imag ? data.imag() : data.real(), idx);
+  }
+
+  ComplexPartWelfordOps(accscalar_t correction)
+      : ops_t(correction, /*take_sqrt=*/false) {}
+};
+
+template <typename scalar_t>
+void std_var_complex_template(TensorIterator& iter, double correction_opt) {
+  using accscalar_t = at::acc_type_device<scalar_t, kXPU>;
+  using real_ops_t =
+      ComplexPartWelfordOps<scalar_t, accscalar_t, scalar_t, false>;
+  using imag_ops_t =
+      ComplexPartWelfordOps<scalar_t, accscalar_t, scalar_t, true>;
+  using ops_t =
+      MultiReduceOps<c10::complex<scalar_t>, real_ops_t, imag_ops_t>;
+  auto correction = static_cast<accscalar_t>(correction_opt);
+  ops_t ops(real_ops_t(correction), imag_ops_t(correction));
+  gpu_reduce_kernel<c10::complex<scalar_t>, scalar_t, 2>(
+      iter, ops, typename ops_t::acc_t{});
+}
+
+void std_var_complex_kernel(TensorIterator& iter, double correction_opt) {
+  AT_DISPATCH_COMPLEX_TYPES_AND(
+      at::ScalarType::ComplexHalf,
+      iter.input_dtype(),
+      "std_var_complex_xpu",
+      [&]() {
+        using real_t = typename scalar_t::value_type;
+        std_var_complex_template<real_t>(iter, correction_opt);
+      });
+}
+
 template <
     typename scalar_t,
     typename acc_t = scalar_t,
@@ -20,6 +20,11 @@ void nansum_kernel(TensorIterator& iter);
 
 void std_var_kernel(TensorIterator& iter, double correction, bool take_sqrt);
 
+// Variances and means of the real and imaginary parts of a complex input in
+// one pass, written to the four outputs of iter as var_real, mean_real,
+// var_imag and mean_imag.
+void std_var_complex_kernel(TensorIterator& iter, double correction);
+
 void aminmax_kernel(TensorIterator& iter);
 
 void aminmax_allreduce_kernel(TensorIterator& iter);
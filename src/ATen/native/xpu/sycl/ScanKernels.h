@@ -7,4 +7,18 @@ void cumsum_kernel(const Tensor& result, const Tensor& self, int64_t dim);
 
 void cumprod_kernel(const Tensor& result, const Tensor& self, int64_t dim);
 
+void cummax_helper_kernel(
+    const Tensor& self,
+    Tensor& values,
+    Tensor& indices,
+    int64_t dim);
+
+void cummin_helper_kernel(
+    const Tensor& self,
+    Tensor& values,
+    Tensor& indices,
+    int64_t dim);
+
+Tensor& logcumsumexp_kernel(const Tensor& self, int64_t dim, Tensor& result);
+
 } // namespace at::native::xpu
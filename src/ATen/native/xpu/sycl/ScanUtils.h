@@ -2,6 +2,7 @@
 
 #include <ATen/native/Resize.h>
 #include <ATen/native/xpu/sycl/BatchKernel.h>
+#include <ATen/native/xpu/sycl/MemoryAccessUtils.h>
 #include <comm/SYCLContext.h>
 #include <comm/TensorInfo.h>
 #include <comm/TensorOptions.h>
@@ -19,133 +20,103 @@ typedef enum {
   INCLUSIVE_TYPE = 1,
 } ScanType;
 
-// group x scan by using up down sweep algorithm(call uds for short)
-template <
-    class LSConfig,
-    class T,
-    class BinaryFunction,
-    bool TrivialOffCal = false>
-T inline group_x_scan_by_uds_for_loop_scan(
-    sycl::nd_item<2> item,
-    const T pre_max_carr,
-    size_t base_off_batch,
-    size_t base_off_problem,
-    sycl::local_ptr<T> slm,
-    LSConfig cfg) {
-  using InputInfo = typename LSConfig::InputInfoType;
-  using OutputInfo = typename LSConfig::OutputInfoType;
-
-  size_t glb_ldr_off_0, glb_ldr_off_1, glb_str_off_0, glb_str_off_1,
-      glb_ldr_logical_off_0, glb_ldr_logical_off_1, glb_str_logical_off_0,
-      glb_str_logical_off_1;
+// Element carried by scans with indices, e.g. cummax. index is the position
+// along the scan dim of the element the value was taken from.
+template <typename scalar_t>
+struct ScanPair {
+  scalar_t value;
+  int64_t index;
+};
 
-  const auto sub_group = item.get_sub_group();
-  const auto sub_group_size = sub_group.get_local_range()[0];
+// Converts between elements of the input and output tensors and the type the
+// scan carries. Plain scans carry the element itself. Scans with indices
+// carry a ScanPair, which is split into the values and indices outputs on
+// store; the indices output shares the layout of the values output.
+template <typename T>
+struct ScanElement {
+  template <typename scalar_t>
+  static inline T load(scalar_t v, int64_t /* index */) {
+    return v;
+  }
 
-  typename LSConfig::item_desc id = cfg.get_item_desc(item);
+  template <class OutputInfo, class IndicesInfo>
+  static inline T reload(
+      const OutputInfo& output,
+      const IndicesInfo& /* indices */,
+      int64_t off) {
+    return output.data[off];
+  }
 
-  const auto lix = item.get_local_id(1);
-  const auto liy = item.get_local_id(0);
-  const auto rx = item.get_local_range(1);
+  template <class OutputInfo, class IndicesInfo>
+  static inline void store(
+      const OutputInfo& output,
+      const IndicesInfo& /* indices */,
+      int64_t off,
+      T v) {
+    output.data[off] = v;
+  }
+};
 
-  size_t ix0 = base_off_problem + lix;
-  size_t ix1 = base_off_problem + rx + lix;
-  size_t glb0 = base_off_batch * cfg.problem_ + ix0;
-  size_t glb1 = base_off_batch * cfg.problem_ + ix1;
-  if constexpr (TrivialOffCal) {
-    glb_ldr_off_0 = glb0;
-    glb_ldr_off_1 = glb1;
-    glb_str_off_0 = glb0;
-    glb_str_off_1 = glb1;
-  } else {
-    glb_ldr_logical_off_0 = glb0;
-    glb_ldr_off_0 = IndexToOffset<typename InputInfo::scalar_t, int64_t>::get(
-        glb_ldr_logical_off_0,
-        cfg.input_,
-        IndexToOffset<typename InputInfo::scalar_t, int64_t>::
-            NON_STRICT_CONTIGUOUS);
-
-    glb_ldr_logical_off_1 = glb1;
-    glb_ldr_off_1 = IndexToOffset<typename InputInfo::scalar_t, int64_t>::get(
-        glb_ldr_logical_off_1,
-        cfg.input_,
-        IndexToOffset<typename InputInfo::scalar_t, int64_t>::
-            NON_STRICT_CONTIGUOUS);
-
-    glb_str_logical_off_0 = glb0;
-    glb_str_off_0 = IndexToOffset<typename OutputInfo::scalar_t, int64_t>::get(
-        glb_str_logical_off_0,
-        cfg.output_,
-        IndexToOffset<typename OutputInfo::scalar_t, int64_t>::
-            NON_STRICT_CONTIGUOUS);
-
-    glb_str_logical_off_1 = glb1;
-    glb_str_off_1 = IndexToOffset<typename OutputInfo::scalar_t, int64_t>::get(
-        glb_str_logical_off_1,
-        cfg.output_,
-        IndexToOffset<typename OutputInfo::scalar_t, int64_t>::
-            NON_STRICT_CONTIGUOUS);
-  }
-  // TODO: opti for bank conflict elemination
-  // Read data from global memory to shared local memory
-  // Each work item load 2 elements from global device memory to shared local
-  // memory
-  if (base_off_batch < cfg.batch_) {
-    if (ix0 < cfg.problem_) {
-      slm[liy * rx * 2 + lix] = cfg.input_.data[glb_ldr_off_0];
-    } else {
-      slm[liy * rx * 2 + lix] = cfg.init_;
-    }
+template <typename scalar_t>
+struct ScanElement<ScanPair<scalar_t>> {
+  using T = ScanPair<scalar_t>;
 
-    if (ix1 < cfg.problem_) {
-      slm[liy * rx * 2 + rx + lix] = cfg.input_.data[glb_ldr_off_1];
-    } else {
-      slm[liy * rx * 2 + rx + lix] = cfg.init_;
-    }
+  static inline T load(T v, int64_t /* index */) {
+    return v;
+  }
 
-    // Add the total value of all previous work groups to the first value of
-    // this work group.
-    if (0 == lix) {
-      slm[liy * rx * 2 + lix] =
-          cfg.func_(slm[liy * rx * 2 + lix], pre_max_carr);
-    }
+  static inline T load(scalar_t v, int64_t index) {
+    return {v, index};
   }
-  item.barrier(sycl::access::fence_space::local_space);
 
-  // Parallel reduction (Up-sweep)
-  for (uint32_t s = rx, d = 1; s >= 1; s >>= 1, d <<= 1) {
-    if (base_off_batch < cfg.batch_ && lix < s) {
-      uint32_t offset = liy * rx * 2 + (2 * lix + 1) * d - 1;
-      slm[offset + d] = cfg.func_(slm[offset], slm[offset + d]);
-    }
-    if (sub_group_size != cfg.wg_range_x_) {
-      item.barrier(sycl::access::fence_space::local_space);
+  template <class OutputInfo, class IndicesInfo>
+  static inline T reload(
+      const OutputInfo& output,
+      const IndicesInfo& indices,
+      int64_t off) {
+    if constexpr (std::is_same_v<typename OutputInfo::scalar_t, T>) {
+      return output.data[off];
+    } else {
+      return {output.data[off], indices.data[off]};
     }
   }
 
-  // Down-sweep
-  for (uint32_t s = 2, d = rx / 2; d >= 1; s <<= 1, d >>= 1) {
-    if (base_off_batch < cfg.batch_ && lix < s - 1) {
-      uint32_t offset = liy * rx * 2 + 2 * (lix + 1) * d - 1;
-      slm[offset + d] = cfg.func_(slm[offset], slm[offset + d]);
-    }
-    if (sub_group_size != cfg.wg_range_x_) {
-      item.barrier(sycl::access::fence_space::local_space);
+  template <class OutputInfo, class IndicesInfo>
+  static inline void store(
+      const OutputInfo& output,
+      const IndicesInfo& indices,
+      int64_t off,
+      T v) {
+    if constexpr (std::is_same_v<typename OutputInfo::scalar_t, T>) {
+      output.data[off] = v;
+    } else {
+      output.data[off] = v.value;
+      indices.data[off] = v.index;
     }
   }
+};
 
-  // Write back from shared local memory to global memory
-  if (base_off_batch < cfg.batch_) {
-    if (ix0 < cfg.problem_) {
-      cfg.output_.data[glb_str_off_0] = slm[liy * rx * 2 + lix];
-    }
-    if (ix1 < cfg.problem_) {
-      cfg.output_.data[glb_str_off_1] = slm[liy * rx * 2 + rx + lix];
+// Number of consecutive elements each work-item of the loop scan scans in
+// registers.
+constexpr int kLoopScanItems = 4;
+
+// Inclusive scan across each segment of `width` consecutive lanes of the
+// sub-group by Kogge-Stone over shuffles. width is a power of two that
+// divides the sub-group size.
+template <typename T, class BinaryFunction>
+inline T sub_group_inclusive_scan(
+    sycl::sub_group sg,
+    T value,
+    BinaryFunction func,
+    uint32_t width) {
+  const uint32_t lane = sg.get_local_linear_id() & (width - 1);
+  for (uint32_t offset = 1; offset < width; offset <<= 1) {
+    T other = sycl::shift_group_right(sg, value, offset);
+    if (lane >= offset) {
+      value = func(other, value);
     }
   }
-
-  // each work item would return current max carr
-  return slm[liy * rx * 2 + 2 * rx - 1];
+  return value;
 }
 
 template <
@@ -160,7 +131,7 @@ class LoopScanConfig {
   using func_t = BinaryFunction;
   using InputInfoType = InputInfo;
   using OutputInfoType = OutputInfo;
-  using IndicesInfoType = OutputInfo;
+  using IndicesInfoType = IndicesInfo;
 
   LoopScanConfig() {}
 
@@ -182,31 +153,14 @@ class LoopScanConfig {
         init_(init),
         type_(type),
         func_(func),
+        vectorized_(false),
         glb_range_x_(0),
         glb_range_y_(0),
         wg_range_x_(0),
-        wg_range_y_(0) {
-    size_t wg_size = syclMaxWorkItemsPerEU();
-    wg_range_x_ = 32;
-    while (problem_ <= wg_range_x_ >> 1) {
-      wg_range_x_ = wg_range_x_ >> 1;
-    }
-    wg_range_y_ = wg_size / wg_range_x_;
-    const auto target_global_size = syclMaxWorkItemsPerTile();
-    ;
-    const size_t max_work_group_num = target_global_size / wg_size;
-    const size_t wg_number =
-        std::min(max_work_group_num, CeilDiv(batch_, wg_range_y_));
-    glb_range_x_ = wg_range_x_;
-    glb_range_y_ = wg_range_y_ * wg_number;
-
-    // For up down sweep algorithm, each work-item handle two elements.
-    // This means that one work group would handle 2 times of work group size
-    // elements.
-    loops_batch = (batch_ + glb_range_y_ - 1) / glb_range_y_;
-    loops_problem = (problem_ + (wg_range_x_ * 2) - 1) / (wg_range_x_ * 2);
-  }
+        wg_range_y_(0),
+        slm_size_(0) {}
 
+  template <class KernelClass>
   static LoopScanConfig<InputInfo, OutputInfo, IndicesInfo, T, BinaryFunction>
   make_config(
       InputInfo& input_info,
@@ -218,15 +172,49 @@ class LoopScanConfig {
       BinaryFunction func) {
     size_t batch = input_info.outerSize(scan_dim);
     size_t problem = input_info.sizes[scan_dim];
-    return {
-        input_info,
-        output_info,
-        indices_info,
-        batch,
-        problem,
-        init,
-        type,
-        func};
+    LoopScanConfig<InputInfo, OutputInfo, IndicesInfo, T, BinaryFunction> cfg =
+        {input_info,
+         output_info,
+         indices_info,
+         batch,
+         problem,
+         init,
+         type,
+         func};
+    cfg.template build<KernelClass>();
+    return cfg;
+  }
+
+  template <class KernelClass>
+  void build() {
+    size_t wg_size = syclMaxWorkGroupSize<KernelClass>();
+    // A row of work-items scans a row of the input. Rows are a power of two
+    // wide, so that no sub-group straddles two rows. Rows shorter than a
+    // sub-group share it, so that short rows keep the lanes busy.
+    size_t row_items = CeilDiv(problem_, (size_t)kLoopScanItems);
+    wg_range_x_ = 1;
+    while (wg_range_x_ < row_items && wg_range_x_ * 2 <= wg_size) {
+      wg_range_x_ <<= 1;
+    }
+    wg_range_y_ = std::max<size_t>(1, wg_size / wg_range_x_);
+    while (wg_range_y_ > 1 && wg_range_y_ / 2 >= batch_) {
+      wg_range_y_ >>= 1;
+    }
+    const size_t max_wg_num =
+        syclMaxWorkItemsPerTile() / (wg_range_x_ * wg_range_y_);
+    const size_t wg_number = std::max<size_t>(
+        1, std::min(max_wg_num, CeilDiv(batch_, wg_range_y_)));
+    glb_range_x_ = wg_range_x_;
+    glb_range_y_ = wg_range_y_ * wg_number;
+    // One total per sub-group of a row.
+    size_t min_sg_size = std::max<int64_t>(1, syclMinSubGroupSize());
+    slm_size_ = wg_range_y_ * CeilDiv(wg_range_x_, min_sg_size);
+
+    loops_batch = CeilDiv(batch_, glb_range_y_);
+    loops_problem = CeilDiv(problem_, wg_range_x_ * kLoopScanItems);
+
+    vectorized_ = problem_ % kLoopScanItems == 0 && is_aligned(input_.data) &&
+        is_aligned(output_.data);
   }
 
   sycl::range<2> global_size() const {
@@ -241,16 +229,12 @@ class LoopScanConfig {
     type_ = other;
   }
 
-  struct item_desc {
-    /* parallel batch, not tensor batch */ size_t glb_batch;
-    /* current global assignment id */ size_t glb_problem;
-  };
-
-  item_desc get_item_desc(sycl::nd_item<2> item) const {
-    auto giy = item.get_global_id(0);
-    auto gix = item.get_global_id(1);
-
-    return {giy, gix};
+ private:
+  template <typename scalar_t>
+  static bool is_aligned(const scalar_t* ptr) {
+    return reinterpret_cast<uintptr_t>(ptr) %
+        alignof(memory::aligned_vector<scalar_t, kLoopScanItems>) ==
+        0;
   }
 
  public:
@@ -265,64 +249,171 @@ class LoopScanConfig {
   int loops_problem;
   ScanType type_;
   BinaryFunction func_;
+  /* rows are aligned for vector access */ bool vectorized_;
   size_t glb_range_x_;
   size_t glb_range_y_;
   size_t wg_range_x_;
   size_t wg_range_y_;
+  size_t slm_size_;
 };
 
-template <typename LSConfig_, bool TrivialOffCal = false>
+// Scans contiguous rows, a row of work-items per row of the input, tile by
+// tile, carrying the total of the previous tiles. Each work-item scans
+// kLoopScanItems consecutive elements in registers, the totals of the items
+// are scanned across the sub-group with shuffles, and shared local memory
+// only exchanges one total per sub-group. All work-items of a row read the
+// same total at a time, so the exchange has no bank conflicts.
+template <typename LSConfig_>
 class LoopScanKernel : public __SYCL_KER_CONFIG_CONVENTION__ {
   using LSConfig = LSConfig_;
   using T = typename LSConfig::arg_t;
-  using BinaryFunction = typename LSConfig::func_t;
+  using InputInfo = typename LSConfig::InputInfoType;
+  using OutputInfo = typename LSConfig::OutputInfoType;
+  using in_vec_t =
+      memory::aligned_vector<typename InputInfo::scalar_t, kLoopScanItems>;
+  using out_vec_t =
+      memory::aligned_vector<typename OutputInfo::scalar_t, kLoopScanItems>;
 
  public:
-  LoopScanKernel(const LSConfig& cfg) : cfg_(cfg), slm_(), max_carr_() {}
+  LoopScanKernel(const LSConfig& cfg) : cfg_(cfg), slm_() {}
 
   void operator()(sycl::nd_item<2> item) const {
-    const int loops_batch = cfg_.loops_batch;
-    const int loops_problem = cfg_.loops_problem;
-    const auto group_size_x = cfg_.wg_range_x_;
-    const auto liy = item.get_local_id(0);
-
-    for (int k = 0,
-             base_off_batch_group = item.get_group(0) * item.get_local_range(0);
-         k < loops_batch && base_off_batch_group < cfg_.batch_;
-         k++, base_off_batch_group += cfg_.glb_range_y_) {
-      max_carr_[liy] = cfg_.init_;
-      int64_t base_off_batch = k * cfg_.glb_range_y_ + item.get_global_id(0);
-      for (int i = 0; i < loops_problem; ++i) {
-        // calculate base addr offset for each loop
-        int64_t base_off_problem = i * group_size_x * 2;
-        max_carr_[liy] = group_x_scan_by_uds_for_loop_scan<
-            LSConfig,
-            T,
-            BinaryFunction,
-            TrivialOffCal>(
-            item, max_carr_[liy], base_off_batch, base_off_problem, slm_, cfg_);
+    auto sg = item.get_sub_group();
+    const int64_t lix = item.get_local_id(1);
+    const int64_t liy = item.get_local_id(0);
+    const int64_t rx = item.get_local_range(1);
+    const int64_t sg_size = sg.get_local_linear_range();
+    const int64_t sg_lane = sg.get_local_linear_id();
+    // Lanes of a row within a sub-group, all of them unless rows are shorter
+    // than a sub-group and share it.
+    const int64_t row_lanes = std::min(rx, sg_size);
+    const int64_t sg_num = std::max<int64_t>(1, rx / sg_size);
+    const int64_t sg_id = lix / sg_size;
+    const int64_t tile_size = rx * kLoopScanItems;
+    const int64_t batch = cfg_.batch_;
+    const int64_t problem = cfg_.problem_;
+
+    for (int k = 0; k < cfg_.loops_batch; k++) {
+      // Uniform across the work-group, which must reach the barriers as one.
+      int64_t group_off = k * cfg_.glb_range_y_ +
+          item.get_group(0) * item.get_local_range(0);
+      if (group_off >= batch) {
+        break;
+      }
+      const int64_t bi = k * cfg_.glb_range_y_ + item.get_global_id(0);
+      const bool active = bi < batch;
+      const int64_t row_off = bi * problem;
+
+      T carry = cfg_.init_;
+      for (int i = 0; i < cfg_.loops_problem; i++) {
+        const int64_t pi = i * tile_size + lix * kLoopScanItems;
+        const bool full_vec = active && cfg_.vectorized_ && pi < problem;
+
+        // Load and reduce the items of the work-item.
+        T x[kLoopScanItems];
+        if (full_vec) {
+          in_vec_t v = *reinterpret_cast<const in_vec_t*>(
+              cfg_.input_.data + row_off + pi);
+#pragma unroll
+          for (int j = 0; j < kLoopScanItems; j++) {
+            x[j] = ScanElement<T>::load(v[j], pi + j);
+          }
+        } else {
+#pragma unroll
+          for (int j = 0; j < kLoopScanItems; j++) {
+            x[j] = cfg_.init_;
+            if (active && pi + j < problem) {
+              x[j] = ScanElement<T>::load(
+                  cfg_.input_.data[row_off + pi + j], pi + j);
+            }
+          }
+        }
+        T total = x[0];
+#pragma unroll
+        for (int j = 1; j < kLoopScanItems; j++) {
+          total = cfg_.func_(total, x[j]);
+        }
+
+        // Prefix of the work-item within the tile, and total of the tile.
+        T incl = sub_group_inclusive_scan(sg, total, cfg_.func_, row_lanes);
+        T excl = sycl::shift_group_right(sg, incl, 1);
+        if (sg_lane % row_lanes == 0) {
+          excl = cfg_.init_;
+        }
+        T prefix = carry;
+        T tile_total;
+        if (sg_num == 1) {
+          tile_total = sycl::select_from_group(
+              sg, incl, sg_lane | (row_lanes - 1));
+        } else {
+          if (sg_lane == sg_size - 1) {
+            slm_[liy * sg_num + sg_id] = incl;
+          }
+          item.barrier(sycl_local_fence);
+          T sg_prefix = cfg_.init_;
+          tile_total = cfg_.init_;
+          for (int64_t s = 0; s < sg_num; s++) {
+            if (s == sg_id) {
+              sg_prefix = tile_total;
+            }
+            tile_total = cfg_.func_(tile_total, slm_[liy * sg_num + s]);
+          }
+          prefix = cfg_.func_(prefix, sg_prefix);
+          // The totals are overwritten by the next tile.
+          item.barrier(sycl_local_fence);
+        }
+        prefix = cfg_.func_(prefix, excl);
+        carry = cfg_.func_(carry, tile_total);
+
+        // Scan the items of the work-item and store them.
+        T y[kLoopScanItems];
+#pragma unroll
+        for (int j = 0; j < kLoopScanItems; j++) {
+          if (cfg_.type_ == INCLUSIVE_TYPE) {
+            prefix = cfg_.func_(prefix, x[j]);
+            y[j] = prefix;
+          } else {
+            y[j] = prefix;
+            prefix = cfg_.func_(prefix, x[j]);
+          }
+        }
+        if constexpr (std::is_same_v<typename OutputInfo::scalar_t, T>) {
+          if (full_vec) {
+            out_vec_t v;
+#pragma unroll
+            for (int j = 0; j < kLoopScanItems; j++) {
+              v[j] = y[j];
+            }
+            *reinterpret_cast<out_vec_t*>(cfg_.output_.data + row_off + pi) =
+                v;
+            continue;
+          }
+        }
+#pragma unroll
+        for (int j = 0; j < kLoopScanItems; j++) {
+          if (active && pi + j < problem) {
+            ScanElement<T>::store(
+                cfg_.output_, cfg_.indices_, row_off + pi + j, y[j]);
+          }
+        }
       }
     }
   }
 
   void sycl_ker_config_convention(sycl::handler& cgh) {
-    int slm_size = cfg_.wg_range_x_ * cfg_.wg_range_y_ * 2;
-    int carr_size = cfg_.wg_range_y_;
-    slm_ = sycl::local_accessor<typename LSConfig::arg_t>(slm_size, cgh);
-    max_carr_ = sycl::local_accessor<typename LSConfig::arg_t>(carr_size, cgh);
+    slm_ = sycl::local_accessor<T>(cfg_.slm_size_, cgh);
   }
 
  private:
   LSConfig cfg_;
   sycl::local_accessor<T> slm_;
-  sycl::local_accessor<T> max_carr_;
 };
 
-template <typename LSConfig, bool TrivialOffCal = false>
+template <typename LSConfig>
 static inline void launch_loop_scan(const LSConfig& cfg) {
   auto& queue = getCurrentSYCLQueue();
 
-  LoopScanKernel<LSConfig, TrivialOffCal> kfn(cfg);
+  LoopScanKernel<LSConfig> kfn(cfg);
 
   sycl_kernel_submit(cfg.global_size(), cfg.group_size(), queue, kfn);
 }
@@ -543,7 +634,8 @@ class SegmentScanKernel : public __SYCL_KER_CONFIG_CONVENTION__ {
     }
     T value = cfg.init_;
     if (id.glb_problem < cfg.problem_ && id.glb_batch < cfg.problem_batch_) {
-      value = cfg.iinfo_.data[glb_ldr_off];
+      value =
+          ScanElement<T>::load(cfg.iinfo_.data[glb_ldr_off], id.glb_problem);
     }
 
     if (cfg.problem_along_x_) {
@@ -559,15 +651,16 @@ class SegmentScanKernel : public __SYCL_KER_CONFIG_CONVENTION__ {
     if (id.glb_batch < cfg.problem_batch_) {
       if (cfg.type_ == INCLUSIVE_TYPE) {
         if (id.glb_problem < cfg.problem_) {
-          cfg.oinfo_.data[glb_str_off] = value;
+          ScanElement<T>::store(cfg.oinfo_, cfg.idxinfo_, glb_str_off, value);
         }
       } else {
         if (id.glb_problem < cfg.problem_ - 1 &&
             id.chunk_off < id.chunk_size - 1) {
-          cfg.oinfo_.data[glb_str_off] = value;
+          ScanElement<T>::store(cfg.oinfo_, cfg.idxinfo_, glb_str_off, value);
         }
         if (id.glb_problem < cfg.problem_ && id.chunk_off == 0) {
-          cfg.oinfo_.data[glb_str_off_0] = cfg.init_;
+          ScanElement<T>::store(
+              cfg.oinfo_, cfg.idxinfo_, glb_str_off_0, cfg.init_);
         }
       }
 
@@ -599,6 +692,8 @@ static inline void launch_segment_scan(const SSConfig& cfg) {
 
 template <class SSConfig, bool TrivialIdxCal = false>
 struct AccumulateCarrierKernelFunctor {
+  using T = typename SSConfig::arg_t;
+
   void operator()(sycl::nd_item<2> item) const {
     auto id = cfg.get_item_desc(item);
     int64_t si, pi, bi, glb_off, crr_off;
@@ -613,8 +708,12 @@ struct AccumulateCarrierKernelFunctor {
       crr_off = si + id.chunk * cfg.stride_ + bi * id.chunk_num * cfg.stride_;
     }
     if (id.glb_problem < cfg.problem_ && id.glb_batch < cfg.problem_batch_) {
-      cfg.oinfo_.data[glb_off] =
-          cfg.func_(cfg.oinfo_.data[glb_off], cfg.carrier_[crr_off]);
+      T value = ScanElement<T>::reload(cfg.oinfo_, cfg.idxinfo_, glb_off);
+      ScanElement<T>::store(
+          cfg.oinfo_,
+          cfg.idxinfo_,
+          glb_off,
+          cfg.func_(value, cfg.carrier_[crr_off]));
     }
   }
   AccumulateCarrierKernelFunctor(const SSConfig cfg_) : cfg(cfg_) {}
@@ -637,12 +736,13 @@ static inline bool dispatch_to_loop_scan_kernel(
   if (batch > 128 && problem < 16384 /*1024 * 16*/) {
     // Only if batch > 128, and problem is not so big, we use loop
     // scan kernel to avoid so many global memory access operations.
-    // If batch is so small, or problem is so big, we use batch scan
-    // to increase work group mumber to increase device coverage.
     return true;
   }
 
-  return false;
+  // The loop scan takes a row of work-items per row, so long rows go to it
+  // as long as there are enough of them to cover the device. Otherwise the
+  // batch scan splits rows into chunks to increase work group number.
+  return batch >= syclMaxWorkItemsPerTile() / syclDeviceMaxWorkGroupSize();
 }
 
 template <class SSConfig, bool TrivialIdxCal = false>
@@ -658,29 +758,32 @@ static inline void accumulate_carrier(const SSConfig& cfg) {
 
 template <
     ScanType Type,
-    bool TrivialOffCal,
     typename T,
     class InputInfo,
     class OutputInfo,
+    class IndicesInfo,
     class BinaryFunction>
 static inline void loop_scan_kernel(
     InputInfo& input_info,
     OutputInfo& output_info,
+    IndicesInfo& indices_info,
     int dim_after_collapse,
     T init,
     BinaryFunction func) {
-  auto cfg =
-      LoopScanConfig<InputInfo, OutputInfo, OutputInfo, T, BinaryFunction>::
-          make_config(
-              input_info,
-              output_info,
-              output_info,
-              dim_after_collapse,
-              init,
-              Type,
-              func);
+  using LSConfig =
+      LoopScanConfig<InputInfo, OutputInfo, IndicesInfo, T, BinaryFunction>;
+  using KernelClass = LoopScanKernel<LSConfig>;
+
+  auto cfg = LSConfig::template make_config<KernelClass>(
+      input_info,
+      output_info,
+      indices_info,
+      dim_after_collapse,
+      init,
+      Type,
+      func);
   TORCH_CHECK(1 == cfg.stride_);
-  launch_loop_scan<decltype(cfg), TrivialOffCal>(cfg);
+  launch_loop_scan(cfg);
 
   return;
 }
@@ -692,35 +795,27 @@ template <
     typename T,
     class InputInfo,
     class OutputInfo,
+    class IndicesInfo,
     class BinaryFunction>
 static inline void _segment_scan_kernel(
     InputInfo& input_info,
     OutputInfo& output_info,
+    IndicesInfo& indices_info,
     int dim_after_collapse,
     T init,
     BinaryFunction func) {
-  using SSConfig = SegmentScanConfig<
-      InputInfo,
-      OutputInfo,
-      OutputInfo /*not used*/,
-      T,
-      BinaryFunction>;
+  using SSConfig =
+      SegmentScanConfig<InputInfo, OutputInfo, IndicesInfo, T, BinaryFunction>;
   using KernelClass = SegmentScanKernel<SSConfig, TrivialOffCal, TrivialIdxCal>;
 
-  auto cfg = SegmentScanConfig<
-      InputInfo,
-      OutputInfo,
-      OutputInfo /*not used*/,
-      T,
-      BinaryFunction>::
-      template make_config<KernelClass>(
-          input_info,
-          output_info,
-          output_info /*not used*/,
-          dim_after_collapse,
-          init,
-          Type,
-          func);
+  auto cfg = SSConfig::template make_config<KernelClass>(
+      input_info,
+      output_info,
+      indices_info,
+      dim_after_collapse,
+      init,
+      Type,
+      func);
   // 0. recursive convergence
   if (cfg.problem_ <= cfg.problem_wg_range_) {
     cfg.set_carrier(nullptr);
@@ -729,17 +824,26 @@ static inline void _segment_scan_kernel(
   }
 
   // 1. inclusive scan in each chunk
+  // The carrier is held as bytes, since a ScanPair has no dtype.
+  int64_t chunk_num = cfg.problem_glb_range_ / cfg.problem_wg_range_;
   Tensor carrier_holder = at::empty(
-      {cfg.batch_, cfg.problem_glb_range_ / cfg.problem_wg_range_, cfg.stride_},
-      map_options<T>());
-  TensorInfo<T, int64_t> carrier_info =
-      getTensorInfo<T, int64_t>(carrier_holder);
+      {cfg.batch_ * chunk_num * cfg.stride_ * (int64_t)sizeof(T)},
+      map_options<uint8_t>());
+  int64_t carrier_sizes[XPU_MAX_TENSORINFO_DIMS] = {
+      cfg.batch_, chunk_num, cfg.stride_};
+  int64_t carrier_strides[XPU_MAX_TENSORINFO_DIMS] = {
+      chunk_num * cfg.stride_, cfg.stride_, 1};
+  TensorInfo<T, int64_t> carrier_info(
+      reinterpret_cast<T*>(carrier_holder.data_ptr()),
+      3,
+      carrier_sizes,
+      carrier_strides);
   cfg.set_carrier(carrier_info.data);
   launch_segment_scan<decltype(cfg), TrivialOffCal, TrivialIdxCal>(cfg);
 
   // 2. recursion for carrier
   _segment_scan_kernel<EXCLUSIVE_TYPE, TrivialOffCal, TrivialIdxCal>(
-      carrier_info, carrier_info, 1, init, func);
+      carrier_info, carrier_info, carrier_info, 1, init, func);
 
   // 3. accumulate among all chunk
   accumulate_carrier<decltype(cfg), TrivialIdxCal>(cfg);
@@ -747,6 +851,49 @@ static inline void _segment_scan_kernel(
   return;
 }
 
+template <
+    ScanType Type,
+    typename T,
+    class InputInfo,
+    class OutputInfo,
+    class IndicesInfo,
+    class BinaryFunction>
+static inline void scan_dispatch(
+    InputInfo& input_info,
+    OutputInfo& output_info,
+    IndicesInfo& indices_info,
+    int dim_after_collapse,
+    T init,
+    BinaryFunction func) {
+  int64_t batch = input_info.outerSize(dim_after_collapse);
+  int64_t stride = input_info.innerSize(dim_after_collapse);
+  int64_t problem = input_info.sizes[dim_after_collapse];
+
+  if (dispatch_to_loop_scan_kernel(problem, stride, batch)) {
+    // Rows are contiguous, as the input and output are.
+    loop_scan_kernel<Type>(
+        input_info, output_info, indices_info, dim_after_collapse, init, func);
+  } else {
+    if (batch == 1 && stride == 1) {
+      _segment_scan_kernel<Type, true, true>(
+          input_info,
+          output_info,
+          indices_info,
+          dim_after_collapse,
+          init,
+          func);
+    } else {
+      _segment_scan_kernel<Type, true, false>(
+          input_info,
+          output_info,
+          indices_info,
+          dim_after_collapse,
+          init,
+          func);
+    }
+  }
+}
+
 template <
     ScanType Type,
     typename scalar_t,
@@ -786,22 +933,50 @@ void scan(
       getTensorInfo<oscalar_t, int64_t>(self);
   output_info.collapseDims(dimension);
 
-  int64_t batch = input_info.outerSize(dim_after_collapse);
-  int64_t stride = input_info.innerSize(dim_after_collapse);
-  int64_t problem = input_info.sizes[dim_after_collapse];
+  scan_dispatch<Type>(
+      input_info,
+      output_info,
+      output_info /* not used */,
+      dim_after_collapse,
+      init,
+      func);
+}
 
-  if (dispatch_to_loop_scan_kernel(problem, stride, batch)) {
-    loop_scan_kernel<Type, true>(
-        input_info, output_info, dim_after_collapse, init, func);
-  } else {
-    if (batch == 1 && stride == 1) {
-      _segment_scan_kernel<Type, true, true>(
-          input_info, output_info, dim_after_collapse, init, func);
-    } else {
-      _segment_scan_kernel<Type, true, false>(
-          input_info, output_info, dim_after_collapse, init, func);
-    }
+// Scan of (value, index) pairs, e.g. cummax, where func combines two
+// ScanPair<scalar_t> and init is its identity. values and indices are the
+// contiguous outputs, indices of dtype long.
+template <ScanType Type, typename scalar_t, class BinaryFunction>
+void scan_with_indices(
+    const Tensor& values,
+    const Tensor& indices,
+    const Tensor& input,
+    int dimension,
+    ScanPair<scalar_t> init,
+    BinaryFunction func) {
+  TORCH_INTERNAL_ASSERT(values.sizes() == input.sizes());
+  TORCH_INTERNAL_ASSERT(indices.sizes() == input.sizes());
+  if (input.numel() == 0) {
+    return;
   }
+  auto input_ = input.contiguous();
+  dimension = maybe_wrap_dim(dimension, input_.dim());
+
+  TORCH_INTERNAL_ASSERT(values.is_contiguous() && indices.is_contiguous());
+
+  TensorInfo<scalar_t, int64_t> input_info =
+      getTensorInfo<scalar_t, int64_t>(input_);
+  int dim_after_collapse = input_info.collapseDims(dimension);
+
+  TensorInfo<scalar_t, int64_t> values_info =
+      getTensorInfo<scalar_t, int64_t>(values);
+  values_info.collapseDims(dimension);
+
+  TensorInfo<int64_t, int64_t> indices_info =
+      getTensorInfo<int64_t, int64_t>(indices);
+  indices_info.collapseDims(dimension);
+
+  scan_dispatch<Type>(
+      input_info, values_info, indices_info, dim_after_collapse, init, func);
 }
 
 } // namespace at::native::xpu
@@ -11,6 +11,7 @@
 #include <ATen/native/ScatterGatherChecks.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/xpu/sycl/Atomics.h>
+#include <ATen/native/xpu/sycl/IndexAssert.h>
 #include <ATen/native/xpu/sycl/OffsetCalculator.h>
 #include <comm/SYCLContext.h>
 
@@ -190,8 +191,15 @@ struct ScatterGatherInternalKernelLoopFunctor {
     auto offsets = offset_calc_.get(i);
 
     int64_t idx_dim = *(int64_t*)(index_ptr_ + offsets[2]);
-    SYCL_KERNEL_ASSERT(
-        idx_dim >= 0 && idx_dim < index_size_ && "index out of bounds");
+    // An out of bounds index leaves self untouched when scattering, and
+    // gathers from index 0 otherwise, so that the output is fully written.
+    if (idx_dim < 0 || idx_dim >= index_size_) {
+      recorder_.record(idx_dim, index_size_);
+      if constexpr (is_scatter_like) {
+        return;
+      }
+      idx_dim = 0;
+    }
 
     f_((scalar_t*)(self_ptr_ + offsets[0]),
        is_scatter_like ? idx_dim * index_stride_ : 0,
@@ -208,7 +216,8 @@ struct ScatterGatherInternalKernelLoopFunctor {
       int64_t index_size,
       int64_t index_stride,
       int64_t numel,
-      func_t f)
+      func_t f,
+      IndexErrorRecorder recorder)
       : self_ptr_(self_ptr),
         src_ptr_(src_ptr),
         index_ptr_(index_ptr),
@@ -216,7 +225,8 @@ struct ScatterGatherInternalKernelLoopFunctor {
         index_size_(index_size),
         index_stride_(index_stride),
         numel_(numel),
-        f_(f) {}
+        f_(f),
+        recorder_(recorder) {}
 
  private:
   char* self_ptr_;
@@ -227,6 +237,7 @@ struct ScatterGatherInternalKernelLoopFunctor {
   int64_t index_stride_;
   int64_t numel_;
   func_t f_;
+  IndexErrorRecorder recorder_;
 };
 
 template <bool is_scatter_like, typename scalar_t>
@@ -264,13 +275,15 @@ struct ScatterGatherInternalKernel {
         index_size,
         index_stride,
         numel,
-        f);
+        f,
+        get_index_error_recorder());
 
     // TODO: optimize it
     constexpr int group_work_items = 256;
     constexpr int work_size_per_item = 4;
     launch_scatter_gather_kernel<group_work_items, work_size_per_item>(
         iter.numel(), loop);
+    maybe_sync_index_errors();
   }
 };
 
@@ -465,6 +478,10 @@ struct ScatterFillInternalKernelLoopFunctor {
   void operator()(int i) const {
     auto offsets = offset_calc_.get(i);
     int64_t idx_dim = *(int64_t*)(index_ptr_ + offsets[1]);
+    if (idx_dim < 0 || idx_dim >= index_size_) {
+      recorder_.record(idx_dim, index_size_);
+      return;
+    }
     char* self_data = self_ptr_ + offsets[0];
     f_((scalar_t*)self_data + idx_dim * index_stride_, (scalar_t*)&src_val_);
   }
@@ -472,23 +489,29 @@ struct ScatterFillInternalKernelLoopFunctor {
       char* self_ptr,
       char* index_ptr,
       offset_calc_t offset_calc,
+      int64_t index_size,
       int64_t index_stride,
       func_t f,
-      scalar_t src_val)
+      scalar_t src_val,
+      IndexErrorRecorder recorder)
       : self_ptr_(self_ptr),
         index_ptr_(index_ptr),
         offset_calc_(offset_calc),
+        index_size_(index_size),
         index_stride_(index_stride),
         f_(f),
-        src_val_(src_val) {}
+        src_val_(src_val),
+        recorder_(recorder) {}
 
  private:
   char* self_ptr_;
   char* index_ptr_;
   offset_calc_t offset_calc_;
+  int64_t index_size_;
   int64_t index_stride_;
   func_t f_;
   scalar_t src_val_;
+  IndexErrorRecorder recorder_;
 };
 
 template <typename scalar_t>
@@ -517,13 +540,22 @@ struct ScatterFillInternalKernel {
     auto loop = ScatterFillInternalKernelLoopFunctor<
         scalar_t,
         decltype(offset_calc),
-        func_t>(self_ptr, index_ptr, offset_calc, index_stride, f, src_val);
+        func_t>(
+        self_ptr,
+        index_ptr,
+        offset_calc,
+        index_size,
+        index_stride,
+        f,
+        src_val,
+        get_index_error_recorder());
 
     // TODO: optimize it
     constexpr int group_work_items = 256;
     constexpr int work_size_per_item = 4;
     launch_scatter_gather_kernel<group_work_items, work_size_per_item>(
         iter.numel(), loop);
+    maybe_sync_index_errors();
   }
 };
 
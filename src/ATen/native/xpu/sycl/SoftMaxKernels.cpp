@@ -1,6 +1,7 @@
 #include <ATen/ATen.h>
 #include <ATen/AccumulateType.h>
 #include <ATen/Dispatch.h>
+#include <ATen/core/Reduction.h>
 #include <ATen/native/CanUse32BitIndexMath.h>
 #include <ATen/native/TensorIterator.h>
 #include <ATen/native/xpu/sycl/Loops.h>
@@ -118,6 +119,51 @@ static inline void softmax_group_reduce_spatial(
   }
 }
 
+// Merges the running max and the sum of exps relative to it of the work
+// items of a group, the sum of each work item is rescaled to the group max.
+template <typename accscalar_t, typename group_t>
+static inline void online_softmax_group_reduce(
+    group_t group,
+    accscalar_t& max_value,
+    accscalar_t& sum_value) {
+  auto group_max =
+      sycl::reduce_over_group(group, max_value, sycl::maximum<accscalar_t>());
+  if (max_value != group_max) {
+    sum_value *= ::exp(max_value - group_max);
+  }
+  max_value = group_max;
+  sum_value =
+      sycl::reduce_over_group(group, sum_value, sycl::plus<accscalar_t>());
+}
+
+// Online softmax update of the running max and sum of exps of a work item
+// with a vector of elements, of which [begin, end) are valid.
+template <int vec_size, typename accscalar_t, typename vec_t>
+static inline void online_softmax_update(
+    const vec_t& in_val,
+    int begin,
+    int end,
+    accscalar_t& max_value,
+    accscalar_t& sum_value) {
+  auto vec_max = max_value;
+#pragma unroll(vec_size)
+  for (int j = 0; j < vec_size; ++j) {
+    if (j >= begin && j < end) {
+      vec_max = std::max(accscalar_t(in_val[j]), vec_max);
+    }
+  }
+  if (vec_max > max_value) {
+    sum_value *= ::exp(max_value - vec_max);
+    max_value = vec_max;
+  }
+#pragma unroll(vec_size)
+  for (int j = 0; j < vec_size; ++j) {
+    if (j >= begin && j < end) {
+      sum_value += ::exp(accscalar_t(in_val[j]) - max_value);
+    }
+  }
+}
+
 template <int SIMD, int vec_size, int NUM, class KernelClass>
 static inline void get_wgroup_size(
     uint64_t dim_size,
@@ -200,7 +246,8 @@ template <
     int outer_loop,
     bool is_masked,
     typename calc_t,
-    typename vec_t>
+    typename vec_t,
+    typename mask_t = bool>
 struct DispatchSoftmaxForwardKernelFunctor
     : public __SYCL_KER_CONFIG_CONVENTION__ {
   [[intel::reqd_sub_group_size(SIMD)]] void operator()(
@@ -218,7 +265,6 @@ struct DispatchSoftmaxForwardKernelFunctor
           (item.get_group(0) * local_size_row_ + lid_row) * dim_size_;
     }
     vec_t reg_in[outer_loop];
-    vec_t reg_mask[outer_loop];
     auto lid_offset = lid_col * vec_size;
     auto local_stride = local_size_ * vec_size;
 
@@ -232,21 +278,26 @@ struct DispatchSoftmaxForwardKernelFunctor
 
       reg_in[i] = *(reinterpret_cast<vec_t*>(in_data_ + group_offset + index));
       if constexpr (is_masked) {
+        // a boolean mask excludes the elements where it is true, any other
+        // mask is added to the input
         auto vec_offset = group_offset + index;
 #pragma unroll(vec_size)
         for (int j = 0; j < vec_size; ++j) {
           auto linear_idx = vec_offset + j;
           auto mask_offset = input_calc_.get(linear_idx)[1];
-          reg_mask[i][j] = mask_data_[mask_offset];
+          if constexpr (std::is_same_v<mask_t, bool>) {
+            if (mask_data_[mask_offset]) {
+              reg_in[i][j] = neginf_;
+            }
+          } else {
+            reg_in[i][j] = static_cast<scalar_t>(
+                accscalar_t(reg_in[i][j]) +
+                accscalar_t(mask_data_[mask_offset]));
+          }
         }
       }
 #pragma unroll(vec_size)
       for (int j = 0; j < vec_size; ++j) {
-        if constexpr (is_masked) {
-          if (reg_mask[i][j]) {
-            reg_in[i][j] = neginf_;
-          }
-        }
         max_value = std::max(max_value, accscalar_t(reg_in[i][j]));
       }
     }
@@ -300,7 +351,8 @@ struct DispatchSoftmaxForwardKernelFunctor
           reg_in[i][j] =
               static_cast<scalar_t>(reg_in[i][j] - max_value - sum_value);
         } else if (sum_value == 0) {
-          reg_in[i][j] = nan_;
+          // a fully masked row is all zeros
+          reg_in[i][j] = is_masked ? scalar_t(0) : nan_;
         } else {
           reg_in[i][j] = static_cast<scalar_t>(
               ::exp(reg_in[i][j] - max_value) * sum_value);
@@ -322,7 +374,7 @@ struct DispatchSoftmaxForwardKernelFunctor
       scalar_t* out_data,
       int dim_size,
       int outer_size,
-      bool* mask_data,
+      mask_t* mask_data,
       calc_t input_calc,
       int sub_group_num,
       int global_size_row,
@@ -350,7 +402,7 @@ struct DispatchSoftmaxForwardKernelFunctor
   scalar_t* out_data_;
   int dim_size_;
   int outer_size_;
-  bool* mask_data_;
+  mask_t* mask_data_;
   calc_t input_calc_;
   int sub_group_num_;
   int global_size_row_;
@@ -376,13 +428,14 @@ template <
     bool LogSoftMax,
     int outer_loop,
     bool is_masked = false,
-    typename calc_t = decltype(nullptr)>
+    typename calc_t = decltype(nullptr),
+    typename mask_t = bool>
 void dispatch_softmax_forward_kernel(
     scalar_t* in_data,
     scalar_t* out_data,
     int dim_size,
     int outer_size,
-    bool* mask_data = nullptr,
+    mask_t* mask_data = nullptr,
     calc_t input_calc = nullptr) {
   using vec_t = at::native::memory::aligned_vector<scalar_t, vec_size>;
   auto& queue = getCurrentSYCLQueue();
@@ -402,7 +455,8 @@ void dispatch_softmax_forward_kernel(
         outer_loop,
         is_masked,
         calc_t,
-        vec_t>;
+        vec_t,
+        mask_t>;
 
     int sub_group_num, global_size_row, local_size_row, range, local_size;
     get_wgroup_size<SIMD, vec_size, outer_loop, KernelClass>(
@@ -444,7 +498,8 @@ void dispatch_softmax_forward_kernel(
         outer_loop,
         is_masked,
         DummyFunctor,
-        vec_t>;
+        vec_t,
+        mask_t>;
 
     int sub_group_num, global_size_row, local_size_row, range, local_size;
     get_wgroup_size<SIMD, vec_size, outer_loop, KernelClass>(
@@ -492,37 +547,22 @@ struct SoftmaxForwardKernelFunctor {
         ((uint64_t)(in_data_ + group_offset)) % align_bytes / sizeof(scalar_t);
     IndexType loops_end = (dim_size_ + start + vec_size - 1) / vec_size;
 
-    // get max value
+    // get max value and sum value in one pass over the row, the sum is kept
+    // relative to the running max and rescaled whenever the max grows
     auto max_value = std::numeric_limits<accscalar_t>::lowest();
-    for (int i = local_id; i < loops_end; i += local_size_) {
-      vec_t in_val = *(reinterpret_cast<vec_t*>(
-          in_data_ + group_offset - start + i * vec_size));
-#pragma unroll(vec_size)
-      for (IndexType j = 0; j < vec_size; ++j) {
-        IndexType linear_idx = i * vec_size + j - start;
-        if (linear_idx >= 0 && linear_idx < dim_size_) {
-          scalar_t in_value = in_val[j];
-          max_value = std::max(accscalar_t(in_value), max_value);
-        }
-      }
-    }
-    max_value = sycl::reduce_over_group(
-        item.get_group(), max_value, sycl::maximum<accscalar_t>());
-
-    // get sum value
     auto sum_value = accscalar_t(0);
     for (IndexType i = local_id; i < loops_end; i += local_size_) {
       vec_t in_val = *(reinterpret_cast<vec_t*>(
           in_data_ + group_offset - start + i * vec_size));
-#pragma unroll(vec_size)
-      for (int j = 0; j < vec_size; ++j) {
-        IndexType linear_idx = i * vec_size + j - start;
-        if (linear_idx >= 0 && linear_idx < dim_size_)
-          sum_value += ::exp(accscalar_t(in_val[j]) - max_value);
-      }
+      int64_t vec_begin = (int64_t)i * vec_size - start;
+      online_softmax_update<vec_size>(
+          in_val,
+          (int)std::max<int64_t>(-vec_begin, 0),
+          (int)std::min<int64_t>(dim_size_ - vec_begin, vec_size),
+          max_value,
+          sum_value);
     }
-    sum_value = sycl::reduce_over_group(
-        item.get_group(), sum_value, sycl::plus<accscalar_t>());
+    online_softmax_group_reduce(item.get_group(), max_value, sum_value);
     if (LogSoftMax)
       sum_value = ::log(sum_value);
     else
@@ -616,6 +656,134 @@ void softmax_forward_kernel(
   sycl_kernel_submit(global_range, local_range, queue, kfn);
 }
 
+// log_softmax followed by nll_loss over the rows of a contiguous (N, C)
+// input. Only the softmax statistics of a row are computed, in one pass, and
+// the log-probability of the target class is derived from them, so the
+// log-probabilities are never written and read back.
+template <
+    int vec_size,
+    typename scalar_t,
+    typename accscalar_t,
+    typename index_t,
+    typename vec_t,
+    int align_bytes>
+struct LogSoftmaxNllLossForwardKernelFunctor {
+  void operator()(sycl::nd_item<1> item) const {
+    int local_id = item.get_local_id(0);
+    int64_t row = item.get_group(0);
+    const scalar_t* row_data = in_data_ + row * dim_size_;
+    int start = ((uint64_t)row_data) % align_bytes / sizeof(scalar_t);
+    int64_t loops_end = (dim_size_ + start + vec_size - 1) / vec_size;
+
+    auto max_value = std::numeric_limits<accscalar_t>::lowest();
+    auto sum_value = accscalar_t(0);
+    for (int64_t i = local_id; i < loops_end; i += local_size_) {
+      vec_t in_val =
+          *(reinterpret_cast<const vec_t*>(row_data - start + i * vec_size));
+      int64_t vec_begin = i * vec_size - start;
+      online_softmax_update<vec_size>(
+          in_val,
+          (int)std::max<int64_t>(-vec_begin, 0),
+          (int)std::min<int64_t>(dim_size_ - vec_begin, vec_size),
+          max_value,
+          sum_value);
+    }
+    online_softmax_group_reduce(item.get_group(), max_value, sum_value);
+
+    if (local_id == 0) {
+      int64_t cur_target = target_data_[row];
+      if (cur_target == ignore_index_) {
+        loss_data_[row] = accscalar_t(0);
+        row_weight_data_[row] = accscalar_t(0);
+        return;
+      }
+      SYCL_KERNEL_ASSERT(cur_target >= 0 && cur_target < dim_size_);
+      accscalar_t cur_weight = has_weight_
+          ? static_cast<accscalar_t>(weight_data_[cur_target])
+          : accscalar_t(1);
+      accscalar_t log_prob = static_cast<accscalar_t>(row_data[cur_target]) -
+          max_value - ::log(sum_value);
+      loss_data_[row] = -log_prob * cur_weight;
+      row_weight_data_[row] = cur_weight;
+    }
+  }
+
+  LogSoftmaxNllLossForwardKernelFunctor(
+      const scalar_t* in_data,
+      const index_t* target_data,
+      const scalar_t* weight_data,
+      accscalar_t* loss_data,
+      accscalar_t* row_weight_data,
+      bool has_weight,
+      int64_t dim_size,
+      int64_t ignore_index,
+      int local_size)
+      : in_data_(in_data),
+        target_data_(target_data),
+        weight_data_(weight_data),
+        loss_data_(loss_data),
+        row_weight_data_(row_weight_data),
+        has_weight_(has_weight),
+        dim_size_(dim_size),
+        ignore_index_(ignore_index),
+        local_size_(local_size) {}
+
+ private:
+  const scalar_t* in_data_;
+  const index_t* target_data_;
+  const scalar_t* weight_data_;
+  accscalar_t* loss_data_;
+  accscalar_t* row_weight_data_;
+  bool has_weight_;
+  int64_t dim_size_;
+  int64_t ignore_index_;
+  int local_size_;
+};
+
+template <int vec_size, typename scalar_t, typename accscalar_t>
+void log_softmax_nll_loss_forward_kernel(
+    const Tensor& input,
+    const Tensor& target,
+    const Tensor& weight,
+    Tensor& loss,
+    Tensor& row_weight,
+    int64_t ignore_index) {
+  using vec_t = at::native::memory::aligned_vector<scalar_t, vec_size>;
+  constexpr int align_bytes = alignof(vec_t);
+  int64_t outer_size = input.size(0);
+  int64_t dim_size = input.size(1);
+  bool has_weight = weight.defined();
+
+  AT_DISPATCH_INDEX_TYPES(
+      target.scalar_type(), "log_softmax_nll_loss_forward_xpu", [&] {
+        using KernelClass = LogSoftmaxNllLossForwardKernelFunctor<
+            vec_size,
+            scalar_t,
+            accscalar_t,
+            index_t,
+            vec_t,
+            align_bytes>;
+        int local_size = std::min<int64_t>(
+            (dim_size + vec_size - 1) / vec_size,
+            syclMaxWorkGroupSize<KernelClass>());
+        auto kfn = KernelClass(
+            input.const_data_ptr<scalar_t>(),
+            target.const_data_ptr<index_t>(),
+            has_weight ? weight.const_data_ptr<scalar_t>() : nullptr,
+            loss.data_ptr<accscalar_t>(),
+            row_weight.data_ptr<accscalar_t>(),
+            has_weight,
+            dim_size,
+            ignore_index,
+            local_size);
+        sycl_kernel_submit(
+            outer_size * local_size,
+            local_size,
+            getCurrentSYCLQueue(),
+            kfn);
+      });
+}
+
 template <
     int vec_size,
     typename scalar_t,
@@ -1703,6 +1871,220 @@ void spatial_softmax_backward(
 #undef SPATIAL_SOFTMAX_BACKWARD_IMPL
 }
 
+// Masked softmax over the last dim of a contiguous input on the register
+// path. The mask is read through an offset calculator, so a broadcast mask,
+// e.g. a key padding mask shared by all heads and queries, is never
+// materialized. Returns false if the row does not fit the register path.
+template <typename scalar_t, typename accscalar_t, typename mask_t>
+bool masked_softmax_forward(
+    Tensor& output,
+    const Tensor& input,
+    const Tensor& mask,
+    int dim) {
+  auto inner_size = input.stride(dim);
+  auto dim_size = input.size(dim);
+  auto outer_size = input.numel() / (inner_size * dim_size);
+
+  constexpr int float4_size = sizeof(float) * 4;
+  constexpr int max_vec_size = float4_size / sizeof(scalar_t);
+  constexpr int INNER_LOOP = max_vec_size * 2;
+
+  using vec_t = at::native::memory::aligned_vector<scalar_t, max_vec_size>;
+  constexpr int align_bytes = alignof(vec_t);
+  int input_start =
+      ((uint64_t)input.const_data_ptr()) % align_bytes / sizeof(scalar_t);
+  int output_start =
+      ((uint64_t)output.const_data_ptr()) % align_bytes / sizeof(scalar_t);
+
+  using DispatchSoftmaxForwardKernel = DispatchSoftmaxForwardKernelFunctor<
+      INNER_LOOP,
+      max_vec_size,
+      SIMD32,
+      scalar_t,
+      accscalar_t,
+      uint32_t,
+      false,
+      INNER_LOOP / max_vec_size,
+      false,
+      DummyFunctor,
+      vec_t>;
+  int max_group_size = syclMaxWorkGroupSize<DispatchSoftmaxForwardKernel>();
+  if (inner_size != 1 || !canUse32BitIndexMath(input) ||
+      max_group_size * INNER_LOOP < dim_size) {
+    return false;
+  }
+
+  auto iter = TensorIteratorConfig()
+                  .set_check_mem_overlap(false)
+                  .check_all_same_dtype(false)
+                  .add_output(output)
+                  .add_const_input(input)
+                  .add_const_input(mask)
+                  .build();
+  auto input_calc = make_input_offset_calculator<2>(iter);
+
+  auto* dev_prop =
+      at::xpu::getDeviceProperties(at::xpu::getDeviceIndexOfCurrentQueue());
+  int SIMD = dev_prop->sub_group_sizes[1];
+  if (SIMD == SIMD32 && dim_size < SIMD16 * INNER_LOOP) {
+    SIMD = SIMD16;
+  }
+  bool aligned = input_start == 0 && output_start == 0 &&
+      dim_size % max_vec_size == 0;
+
+#define DISPATCH_MASKED_SOFTMAX_FORWARD_IMPL(vec_size, SIMD, outer_loop) \
+  {                                                                      \
+    dispatch_softmax_forward_kernel<                                     \
+        INNER_LOOP,                                                      \
+        vec_size,                                                        \
+        SIMD,                                                            \
+        scalar_t,                                                        \
+        accscalar_t,                                                     \
+        uint32_t,                                                        \
+        false,                                                           \
+        outer_loop,                                                      \
+        true,                                                            \
+        decltype(input_calc),                                            \
+        mask_t>(                                                         \
+        input.data_ptr<scalar_t>(),                                      \
+        output.data_ptr<scalar_t>(),                                     \
+        dim_size,                                                        \
+        outer_size,                                                      \
+        mask.data_ptr<mask_t>(),                                         \
+        input_calc);                                                     \
+  }
+
+  if (SIMD == SIMD32) {
+    if (aligned) {
+      DISPATCH_MASKED_SOFTMAX_FORWARD_IMPL(
+          /*vec_size*/ max_vec_size,
+          /*SIMD*/ SIMD32,
+          /*outer_loop*/ INNER_LOOP / max_vec_size);
+    } else {
+      DISPATCH_MASKED_SOFTMAX_FORWARD_IMPL(
+          /*vec_size*/ 1, /*SIMD*/ SIMD32, /*outer_loop*/ INNER_LOOP);
+    }
+  } else {
+    // SIMD16 will use less register numbers than SIMD32
+    // if the SIMD = SIMD16, then outer_loop will be enlarged 2x
+    if (aligned) {
+      DISPATCH_MASKED_SOFTMAX_FORWARD_IMPL(
+          /*vec_size*/ max_vec_size,
+          /*SIMD*/ SIMD16,
+          /*outer_loop*/ INNER_LOOP / max_vec_size * 2);
+    } else {
+      DISPATCH_MASKED_SOFTMAX_FORWARD_IMPL(
+          /*vec_size*/ 1, /*SIMD*/ SIMD16, /*outer_loop*/ INNER_LOOP * 2);
+    }
+  }
+#undef DISPATCH_MASKED_SOFTMAX_FORWARD_IMPL
+  return true;
+}
+
+// Backward of masked softmax with a boolean mask on the register path, the
+// output is taken as zero where the mask is true. Returns false if the row
+// does not fit the register path.
+template <typename scalar_t, typename accscalar_t>
+bool masked_softmax_backward(
+    Tensor& gradInput,
+    const Tensor& output,
+    const Tensor& gradOutput,
+    const Tensor& mask,
+    int dim) {
+  auto inner_size = output.stride(dim);
+  auto dim_size = output.size(dim);
+  auto outer_size = output.numel() / (dim_size * inner_size);
+
+  constexpr int float4_size = sizeof(float) * 4;
+  constexpr int max_vec_size = float4_size / sizeof(scalar_t);
+  constexpr int INNER_LOOP = max_vec_size;
+
+  using vec_t = at::native::memory::aligned_vector<scalar_t, max_vec_size>;
+  constexpr int align_bytes = alignof(vec_t);
+  int gradin_start =
+      ((uint64_t)gradInput.const_data_ptr()) % align_bytes / sizeof(scalar_t);
+  int output_start =
+      ((uint64_t)output.const_data_ptr()) % align_bytes / sizeof(scalar_t);
+  int gradoutput_start =
+      ((uint64_t)gradOutput.const_data_ptr()) % align_bytes / sizeof(scalar_t);
+
+  constexpr int NUM = INNER_LOOP / max_vec_size;
+  using DispatchSoftmaxBackwardKernel = DispatchSoftmaxBackwardKernelFunctor<
+      INNER_LOOP,
+      max_vec_size,
+      SIMD32,
+      scalar_t,
+      accscalar_t,
+      uint32_t,
+      false,
+      false,
+      DummyFunctor,
+      vec_t,
+      NUM>;
+  int max_group_size = syclMaxWorkGroupSize<DispatchSoftmaxBackwardKernel>();
+  if (inner_size != 1 || !canUse32BitIndexMath(output) ||
+      max_group_size * INNER_LOOP < dim_size) {
+    return false;
+  }
+
+  auto iter = TensorIteratorConfig()
+                  .set_check_mem_overlap(false)
+                  .check_all_same_dtype(false)
+                  .add_output(gradInput)
+                  .add_const_input(output)
+                  .add_const_input(mask)
+                  .build();
+  auto input_calc = make_input_offset_calculator<2>(iter);
+
+  auto* dev_prop =
+      at::xpu::getDeviceProperties(at::xpu::getDeviceIndexOfCurrentQueue());
+  int SIMD = dev_prop->sub_group_sizes[1];
+  if (SIMD == SIMD32 && dim_size < SIMD16 * max_vec_size) {
+    SIMD = SIMD16;
+  }
+  bool aligned = gradin_start == 0 && output_start == 0 &&
+      gradoutput_start == 0 && dim_size % max_vec_size == 0;
+
+#define DISPATCH_MASKED_SOFTMAX_BACKWARD_IMPL(vec_size, SIMD) \
+  {                                                           \
+    dispatch_softmax_backward_kernel<                         \
+        INNER_LOOP,                                           \
+        vec_size,                                             \
+        SIMD,                                                 \
+        scalar_t,                                             \
+        accscalar_t,                                          \
+        uint32_t,                                             \
+        false,                                                \
+        true,                                                 \
+        decltype(input_calc)>(                                \
+        gradInput.data_ptr<scalar_t>(),                       \
+        output.data_ptr<scalar_t>(),                          \
+        gradOutput.data_ptr<scalar_t>(),                      \
+        dim_size,                                             \
+        outer_size,                                           \
+        mask.data_ptr<bool>(),                                \
+        input_calc);                                          \
+  }
+
+  if (SIMD == SIMD32) {
+    if (aligned) {
+      DISPATCH_MASKED_SOFTMAX_BACKWARD_IMPL(
+          /*vec_size*/ max_vec_size, /*SIMD*/ SIMD32);
+    } else {
+      DISPATCH_MASKED_SOFTMAX_BACKWARD_IMPL(/*vec_size*/ 1, /*SIMD*/ SIMD32);
+    }
+  } else {
+    if (aligned) {
+      DISPATCH_MASKED_SOFTMAX_BACKWARD_IMPL(
+          /*vec_size*/ max_vec_size, /*SIMD*/ SIMD16);
+    } else {
+      DISPATCH_MASKED_SOFTMAX_BACKWARD_IMPL(/*vec_size*/ 1, /*SIMD*/ SIMD16);
+    }
+  }
+#undef DISPATCH_MASKED_SOFTMAX_BACKWARD_IMPL
+  return true;
+}
+
 #undef MIN_WG_NUM
 #undef SIMD16
 #undef SIMD32
@@ -1830,6 +2212,215 @@ Tensor& _log_softmax_backward_kernel(
       grad.contiguous(), output.contiguous(), dim, half_to_float, grad_input);
 }
 
+Tensor masked_softmax_kernel(
+    const Tensor& input_,
+    const Tensor& mask_,
+    const c10::optional<int64_t> dim_,
+    const c10::optional<int64_t> mask_type_) {
+  TORCH_CHECK(
+      mask_.scalar_type() == ScalarType::Bool ||
+          at::isFloatingType(mask_.scalar_type()),
+      "Mask should be a boolean or an additive floating point tensor");
+  Tensor input = input_.dim() == 0 ? input_.view(1) : input_.contiguous();
+  int64_t dim = maybe_wrap_dim(dim_.value_or(input.dim() - 1), input.dim());
+  Tensor output = at::empty_like(input, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  if (input.numel() == 0) {
+    return output.view(input_.sizes());
+  }
+
+  // As in the CPU and CUDA kernels, the mask is an (L, L) src_mask
+  // (mask_type 0) or a (B, L) src_key_padding_mask (mask_type 1) of a
+  // (B, H, L, L) input, or else has the shape of the input.
+  Tensor mask = mask_.scalar_type() == ScalarType::Bool
+      ? mask_
+      : mask_.to(input.scalar_type());
+  int64_t mask_type = mask_type_.value_or(2);
+  TORCH_CHECK(
+      mask_type >= 0 && mask_type <= 2,
+      "Mask Type should be 0 (src_mask), 1 (src_key_padding_mask), or 2 (default_mask)");
+  if (mask.dim() != 2 || input.dim() != 4) {
+    mask_type = 2;
+  }
+  if (mask_type == 0) {
+    TORCH_CHECK(
+        input.size(2) == mask.size(0) && input.size(3) == mask.size(1),
+        "For mask_type == 0 mask shape should be (L, L)");
+    mask = mask.view({1, 1, mask.size(0), mask.size(1)});
+  } else if (mask_type == 1) {
+    TORCH_CHECK(
+        input.size(0) == mask.size(0) && input.size(3) == mask.size(1),
+        "For mask_type == 1 mask shape should be (B, L)");
+    mask = mask.view({mask.size(0), 1, 1, mask.size(1)});
+  } else {
+    TORCH_CHECK(
+        mask_.sizes() == input_.sizes(),
+        "Mask shape should match input. mask: ",
+        mask_.sizes(),
+        " input: ",
+        input_.sizes());
+  }
+  mask = mask.expand(input.sizes());
+
+  bool done = false;
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      at::ScalarType::BFloat16,
+      at::ScalarType::Half,
+      input.scalar_type(),
+      "masked_softmax_xpu",
+      [&] {
+        using accscalar_t = acc_type_device<scalar_t, kXPU>;
+        if (mask.scalar_type() == ScalarType::Bool) {
+          done = impl::masked_softmax_forward<scalar_t, accscalar_t, bool>(
+              output, input, mask, dim);
+        } else {
+          done =
+              impl::masked_softmax_forward<scalar_t, accscalar_t, scalar_t>(
+                  output, input, mask, dim);
+        }
+      });
+  if (!done) {
+    // Rows off the register path, masked elements and fully masked rows
+    // are zeroed after a regular softmax.
+    if (mask.scalar_type() == ScalarType::Bool) {
+      host_softmax<false>(
+          input.masked_fill(mask, -std::numeric_limits<double>::infinity()),
+          dim,
+          false,
+          output);
+      output.masked_fill_(mask, 0);
+    } else {
+      Tensor masked_input = input + mask;
+      host_softmax<false>(masked_input, dim, false, output);
+      output.masked_fill_(
+          masked_input.eq(-std::numeric_limits<double>::infinity())
+              .all(dim, /*keepdim=*/true),
+          0);
+    }
+  }
+  return output.view(input_.sizes());
+}
+
+Tensor masked_softmax_backward_kernel(
+    const Tensor& grad_,
+    const Tensor& output_,
+    const Tensor& mask_,
+    const c10::optional<int64_t> dim_) {
+  Tensor grad_input = at::empty_like(grad_, LEGACY_CONTIGUOUS_MEMORY_FORMAT);
+  if (grad_.numel() == 0) {
+    return grad_input;
+  }
+  Tensor grad = grad_.dim() == 0 ? grad_.view(1) : grad_.contiguous();
+  Tensor output = output_.dim() == 0 ? output_.view(1) : output_.contiguous();
+  int64_t dim = maybe_wrap_dim(dim_.value_or(grad.dim() - 1), grad.dim());
+  TORCH_CHECK(
+      grad.sizes() == output.sizes(),
+      "Output shape should match grad shape");
+  Tensor grad_input_ = grad_input.view(grad.sizes());
+
+  // The output of an additive mask is already zero where the mask is -inf
+  if (mask_.scalar_type() != ScalarType::Bool) {
+    return host_softmax_backward<false>(grad, output, dim, false, grad_input_)
+        .view(grad_.sizes());
+  }
+  TORCH_CHECK(
+      mask_.sizes() == grad_.sizes(),
+      "Mask shape should match grad shape. mask: ",
+      mask_.sizes(),
+      " grad: ",
+      grad_.sizes());
+  Tensor mask = mask_.reshape(grad.sizes());
+
+  bool done = false;
+  AT_DISPATCH_FLOATING_TYPES_AND2(
+      at::ScalarType::BFloat16,
+      at::ScalarType::Half,
+      grad.scalar_type(),
+      "masked_softmax_backward_xpu",
+      [&] {
+        using accscalar_t = acc_type_device<scalar_t, kXPU>;
+        done = impl::masked_softmax_backward<scalar_t, accscalar_t>(
+            grad_input_, output, grad, mask, dim);
+      });
+  if (!done) {
+    host_softmax_backward<false>(
+        grad, output.masked_fill(mask, 0), dim, false, grad_input_);
+  }
+  return grad_input;
+}
+
+Tensor log_softmax_nll_loss_kernel(
+    const Tensor& input_,
+    const Tensor& target_,
+    const Tensor& weight_,
+    int64_t reduction,
+    int64_t ignore_index) {
+  TORCH_CHECK(
+      input_.dim() == 1 || input_.dim() == 2,
+      "log_softmax_nll_loss: expected input of 1 or 2 dimensions, got ",
+      input_.dim());
+  TORCH_CHECK(
+      target_.dim() == input_.dim() - 1,
+      "log_softmax_nll_loss: expected target of ",
+      input_.dim() - 1,
+      " dimensions, got ",
+      target_.dim());
+  Tensor input = input_.dim() == 1 ? input_.unsqueeze(0) : input_;
+  input = input.contiguous();
+  Tensor target = target_.reshape({-1}).contiguous();
+  const int64_t batch_size = input.size(0);
+  const int64_t n_classes = input.size(1);
+  TORCH_CHECK(
+      target.numel() == batch_size,
+      "log_softmax_nll_loss: expected input batch_size (",
+      batch_size,
+      ") to match target batch_size (",
+      target.numel(),
+      ")");
+  TORCH_CHECK(
+      n_classes > 0, "log_softmax_nll_loss: expected a non-empty class dim");
+  Tensor weight;
+  if (weight_.defined()) {
+    TORCH_CHECK(
+        weight_.numel() == n_classes,
+        "log_softmax_nll_loss: expected weight to be a 1D tensor of size ",
+        n_classes,
+        ", got ",
+        weight_.sizes());
+    weight = weight_.to(input.scalar_type()).contiguous();
+  }
+
+  // Per-row loss and weight, reduced in the accumulate type
+  auto acc_options = input.options().dtype(
+      at::toAccumulateType(input.scalar_type(), kXPU));
+  Tensor loss = at::empty({batch_size}, acc_options);
+  Tensor row_weight = at::empty({batch_size}, acc_options);
+  if (batch_size > 0) {
+    AT_DISPATCH_FLOATING_TYPES_AND2(
+        at::ScalarType::BFloat16,
+        at::ScalarType::Half,
+        input.scalar_type(),
+        "log_softmax_nll_loss_xpu",
+        [&] {
+          using accscalar_t = acc_type_device<scalar_t, kXPU>;
+          constexpr int vec_size = sizeof(float) * 4 / sizeof(scalar_t);
+          impl::log_softmax_nll_loss_forward_kernel<
+              vec_size,
+              scalar_t,
+              accscalar_t>(
+              input, target, weight, loss, row_weight, ignore_index);
+        });
+  }
+
+  if (reduction == at::Reduction::None) {
+    return loss.to(input.scalar_type()).view(target_.sizes());
+  }
+  Tensor total = loss.sum();
+  if (reduction == at::Reduction::Mean) {
+    total.div_(row_weight.sum());
+  }
+  return total.to(input.scalar_type());
+}
+
 } // namespace xpu
 } // namespace native
 } // namespace at
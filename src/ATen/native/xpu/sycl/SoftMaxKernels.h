@@ -32,6 +32,30 @@ Tensor& _log_softmax_backward_kernel(
     bool half_to_float,
     Tensor& grad_input);
 
+// Softmax with a boolean mask, true excludes an element, or with an additive
+// mask. The mask broadcasts to the input, and fully masked rows are zeros.
+Tensor masked_softmax_kernel(
+    const Tensor& input,
+    const Tensor& mask,
+    const c10::optional<int64_t> dim,
+    const c10::optional<int64_t> mask_type);
+
+Tensor masked_softmax_backward_kernel(
+    const Tensor& grad,
+    const Tensor& output,
+    const Tensor& mask,
+    const c10::optional<int64_t> dim);
+
+// log_softmax over the classes of a (C) or (N, C) input followed by nll_loss,
+// computed from per-row softmax statistics in a single pass over the input.
+// Forward only.
+Tensor log_softmax_nll_loss_kernel(
+    const Tensor& input,
+    const Tensor& target,
+    const Tensor& weight,
+    int64_t reduction,
+    int64_t ignore_index);
+
 } // namespace xpu
 } // namespace native
 } // namespace at
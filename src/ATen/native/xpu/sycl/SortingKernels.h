@@ -5,6 +5,9 @@
 #include <c10/core/Allocator.h>
 #include <comm/SYCLContext.h>
 
+#include <cstdlib>
+#include <string>
+
 namespace at {
 namespace native {
 namespace xpu {
@@ -24,7 +27,7 @@ struct SegmentedGroupRadixSortPairsFunctor
         values_in_ == nullptr ? nullptr : values_in_ + seg_offset,
         num_elements_);
     int begin_bit = 0;
-    int end_bit = KeyTraits<key_t>::endbit();
+    int end_bit = end_bit_;
     while (true) {
       method.rank_keys(begin_bit, end_bit);
       method.exchange_keys();
@@ -44,12 +47,14 @@ struct SegmentedGroupRadixSortPairsFunctor
       key_t* keys_out,
       const value_t* values_in,
       value_t* values_out,
-      int num_elements)
+      int num_elements,
+      int end_bit)
       : keys_in_(keys_in),
         keys_out_(keys_out),
         values_in_(values_in),
         values_out_(values_out),
-        num_elements_(num_elements) {}
+        num_elements_(num_elements),
+        end_bit_(end_bit) {}
 
  private:
   const key_t* keys_in_;
@@ -57,6 +62,7 @@ struct SegmentedGroupRadixSortPairsFunctor
   const value_t* values_in_;
   value_t* values_out_;
   int num_elements_;
+  int end_bit_;
   sycl_local_acc_t<char> slm_;
 };
 
@@ -73,7 +79,8 @@ void segmented_group_radix_sort_pairs_kernel(
     const value_t* values_in,
     value_t* values_out,
     int num_segments,
-    int num_elements) {
+    int num_elements,
+    int end_bit) {
   using method_t = GroupRadixSort<
       key_t,
       GROUP_SIZE,
@@ -82,7 +89,7 @@ void segmented_group_radix_sort_pairs_kernel(
       IS_DESCENDING,
       value_t>;
   auto caller = SegmentedGroupRadixSortPairsFunctor<method_t, key_t, value_t>(
-      keys_in, keys_out, values_in, values_out, num_elements);
+      keys_in, keys_out, values_in, values_out, num_elements, end_bit);
   sycl_kernel_submit(
       num_segments * GROUP_SIZE,
       GROUP_SIZE,
@@ -328,14 +335,16 @@ void segmented_radix_sort_pairs_kernel(
     const value_t* values_in,
     value_t* values_out,
     int num_segments,
-    int num_elements) {
+    int num_elements,
+    int end_bit) {
   constexpr int TILE_PROCESSING_LENGTH = GROUP_SIZE * KEYS_PER_ITEM;
   int num_tiles =
       (num_elements + TILE_PROCESSING_LENGTH - 1) / TILE_PROCESSING_LENGTH;
   constexpr int RADIX_BITS = 4;
   constexpr int RADIX_BUCKETS = 16;
   int begin_bit = 0;
-  int end_bit = KeyTraits<key_t>::endbit();
+  int num_passes =
+      std::max(1, (end_bit - begin_bit + RADIX_BITS - 1) / RADIX_BITS);
   int* counts;
   key_t* keys_temp;
   value_t* values_temp;
@@ -351,12 +360,28 @@ void segmented_radix_sort_pairs_kernel(
   keys_temp = (key_t*)keys_temp_data.get();
   values_temp = (value_t*)values_temp_data.get();
 
-  key_t* keys_in_ = const_cast<key_t*>(keys_in);
-  key_t* keys_out_ = keys_temp;
-  value_t* values_in_ = const_cast<value_t*>(values_in);
-  value_t* values_out_ = values_temp;
+  // Passes ping-pong between the temporary and output buffers. The first
+  // pass writes to whichever lets the last one end in the output.
+  const key_t* keys_in_ = keys_in;
+  key_t* keys_out_ = num_passes % 2 ? keys_out : keys_temp;
+  const value_t* values_in_ = values_in;
+  value_t* values_out_ = num_passes % 2 ? values_out : values_temp;
+  if (num_passes % 2 &&
+      (keys_in == keys_out ||
+       (values_in != nullptr && values_in == values_out))) {
+    // A pass cannot scatter in place, so in-place sorts with an odd number
+    // of passes start from a copy of the input in the temporary buffers.
+    auto& q = at::xpu::getCurrentSYCLQueue();
+    int64_t numel = (int64_t)num_segments * num_elements;
+    q.memcpy(keys_temp, keys_in, numel * sizeof(key_t));
+    keys_in_ = keys_temp;
+    if (values_in != nullptr) {
+      q.memcpy(values_temp, values_in, numel * sizeof(value_t));
+      values_in_ = values_temp;
+    }
+  }
 
-  while (true) {
+  for (int pass = 0; pass < num_passes; ++pass) {
     segmented_radix_sort_pairs_upsweep_kernel<
         key_t,
         value_t,
@@ -388,18 +413,11 @@ void segmented_radix_sort_pairs_kernel(
         end_bit,
         counts);
 
-    if (begin_bit == 0) {
-      keys_in_ = keys_temp;
-      keys_out_ = keys_out;
-      values_in_ = values_temp;
-      values_out_ = values_out;
-    } else {
-      std::swap(keys_in_, keys_out_);
-      std::swap(values_in_, values_out_);
-    }
+    keys_in_ = keys_out_;
+    keys_out_ = keys_out_ == keys_out ? keys_temp : keys_out;
+    values_in_ = values_out_;
+    values_out_ = values_out_ == values_out ? values_temp : values_out;
     begin_bit += RADIX_BITS;
-    if (begin_bit >= end_bit)
-      break;
   }
 }
 
@@ -419,8 +437,15 @@ struct SegmentedGroupRadixSelectPairsFunctor
 
   [[intel::reqd_sub_group_size(method_t::SUBGROUP_SIZE)]] void operator()(
       sycl::nd_item<1> item) const {
-    int seg_idx = item.get_group(0);
-    int seg_offset = seg_idx * nelements_;
+    // Chunks of a segment are selected independently, the last chunk takes
+    // the remainder of the segment.
+    int seg_idx = item.get_group(0) / nchunks_;
+    int chunk_idx = item.get_group(0) % nchunks_;
+    int64_t seg_offset =
+        (int64_t)seg_idx * nelements_ + (int64_t)chunk_idx * chunk_size_;
+    int nelements = chunk_idx == nchunks_ - 1
+        ? nelements_ - chunk_idx * chunk_size_
+        : chunk_size_;
     auto method = method_t(item, slm_);
 
     auto keys_in_seg = keys_in_ + seg_offset;
@@ -434,27 +459,27 @@ struct SegmentedGroupRadixSelectPairsFunctor
         reinterpret_cast<char*>(keys_temp) +
         make_alignment_n<MAX_KV_BYTES>(k_ * sizeof(key_t)));
 
-    method.load_keys(keys_in_seg, nelements_);
-    method.load_values(values_in_seg, nelements_);
+    method.load_keys(keys_in_seg, nelements);
+    method.load_values(values_in_seg, nelements);
 
     int num_start = method_t::PROCESSING_LENGTH;
-    while (num_start < nelements_) {
+    while (num_start < nelements) {
       method.topk(KeyTraits<key_t>::endbit(), 0, k_, keys_temp, values_temp);
       item.barrier(sycl_local_fence);
-      method.topk_append_keys(
-          keys_in_seg, keys_temp, nelements_, num_start, k_);
+      method.topk_append_keys(keys_in_seg, keys_temp, nelements, num_start, k_);
       method.topk_append_values(
-          values_in_seg, values_temp, nelements_, num_start, k_);
+          values_in_seg, values_temp, nelements, num_start, k_);
       num_start += method_t::PROCESSING_LENGTH - k_;
       item.barrier(sycl_local_fence);
     }
 
+    int64_t out_offset = (int64_t)item.get_group(0) * k_;
     method.topk(
         KeyTraits<key_t>::endbit(),
         0,
         k_,
-        keys_out_ + seg_idx * k_,
-        values_out_ + seg_idx * k_);
+        keys_out_ + out_offset,
+        values_out_ + out_offset);
   }
 
   void sycl_ker_config_convention(sycl::handler& cgh) {
@@ -471,13 +496,16 @@ struct SegmentedGroupRadixSelectPairsFunctor
       const value_t* values_in,
       value_t* values_out,
       int nelements,
-      int k)
+      int k,
+      int nchunks)
       : keys_in_(keys_in),
         keys_out_(keys_out),
         values_in_(values_in),
         values_out_(values_out),
         nelements_(nelements),
-        k_(k) {}
+        k_(k),
+        nchunks_(nchunks),
+        chunk_size_(nelements / nchunks) {}
 
  private:
   const key_t* keys_in_;
@@ -486,6 +514,8 @@ struct SegmentedGroupRadixSelectPairsFunctor
   value_t* values_out_;
   int nelements_;
   int k_;
+  int nchunks_;
+  int chunk_size_;
   sycl_local_acc_t<char> slm_;
 };
 
@@ -503,7 +533,8 @@ inline void group_radix_select_pairs_kernel(
     value_t* values_out,
     int num_segments,
     int num_elements,
-    int k) {
+    int k,
+    int num_chunks) {
   using method_t = GroupRadixSort<
       key_t,
       GROUP_SIZE,
@@ -512,19 +543,256 @@ inline void group_radix_select_pairs_kernel(
       IS_DESCENDING,
       value_t>;
   TORCH_CHECK(k <= method_t::PROCESSING_LENGTH);
+  TORCH_CHECK(k <= num_elements / num_chunks);
   auto caller = SegmentedGroupRadixSelectPairsFunctor<method_t, key_t, value_t>(
-      keys_in, keys_out, values_in, values_out, num_elements, k);
+      keys_in, keys_out, values_in, values_out, num_elements, k, num_chunks);
   sycl_kernel_submit(
-      num_segments * GROUP_SIZE,
+      (int64_t)num_segments * num_chunks * GROUP_SIZE,
       GROUP_SIZE,
       at::xpu::getCurrentSYCLQueue(),
       caller);
 }
 
+// ======================= sub-group bitonic sort =======================
+
+// Segments of up to SUBGROUP_SIZE elements are sorted in registers, one
+// element per work-item, exchanging keys by sub-group shuffles. Segments are
+// padded to a power of two PADDED_N, and SUBGROUP_SIZE / PADDED_N segments
+// share a sub-group. Ties are broken by position in the segment, so the sort
+// is stable like the radix sorts.
+template <
+    typename key_t,
+    typename value_t,
+    bool IS_DESCENDING,
+    int SUBGROUP_SIZE>
+struct SegmentedSubGroupBitonicSortPairsFunctor {
+  using KeyTraitsT = typename KeyTraits<key_t>::Type;
+
+  // Padding elements go last.
+  static inline bool precedes(
+      KeyTraitsT ukey_a,
+      int pos_a,
+      bool valid_a,
+      KeyTraitsT ukey_b,
+      int pos_b,
+      bool valid_b) {
+    if (valid_a != valid_b)
+      return valid_a;
+    if (ukey_a != ukey_b)
+      return IS_DESCENDING ? ukey_a > ukey_b : ukey_a < ukey_b;
+    return pos_a < pos_b;
+  }
+
+  [[intel::reqd_sub_group_size(SUBGROUP_SIZE)]] void operator()(
+      sycl::nd_item<1> item) const {
+    auto sg = item.get_sub_group();
+    int64_t seg_idx = item.get_global_linear_id() / padded_n_;
+    int lane = item.get_global_linear_id() % padded_n_;
+    int64_t offset = seg_idx * num_elements_ + lane;
+
+    KeyTraitsT ukey = 0;
+    value_t value{};
+    int pos = lane;
+    bool valid = seg_idx < num_segments_ && lane < num_elements_;
+    if (valid) {
+      ukey = KeyTraits<key_t>::convert(c10::load(&keys_in_[offset]));
+      if constexpr (std::is_integral<value_t>::value) {
+        value = values_in_ == nullptr ? lane : values_in_[offset];
+      } else {
+        value = values_in_[offset];
+      }
+    }
+
+    // Each step compares lanes lane and lane ^ j. The lower lane of a
+    // pair keeps the preceding element in ascending blocks of size k.
+    for (int k = 2; k <= padded_n_; k <<= 1) {
+      for (int j = k >> 1; j > 0; j >>= 1) {
+        KeyTraitsT other_ukey = sycl::permute_group_by_xor(sg, ukey, j);
+        value_t other_value = sycl::permute_group_by_xor(sg, value, j);
+        int other_pos = sycl::permute_group_by_xor(sg, pos, j);
+        bool other_valid = sycl::permute_group_by_xor(sg, valid, j);
+        bool keep_first = ((lane & j) == 0) == ((lane & k) == 0);
+        bool take_other = keep_first
+            ? precedes(other_ukey, other_pos, other_valid, ukey, pos, valid)
+            : precedes(ukey, pos, valid, other_ukey, other_pos, other_valid);
+        if (take_other) {
+          ukey = other_ukey;
+          value = other_value;
+          pos = other_pos;
+          valid = other_valid;
+        }
+      }
+    }
+
+    if (seg_idx < num_segments_ && lane < num_elements_) {
+      keys_out_[offset] = KeyTraits<key_t>::deconvert(ukey);
+      values_out_[offset] = value;
+    }
+  }
+
+  SegmentedSubGroupBitonicSortPairsFunctor(
+      const key_t* keys_in,
+      key_t* keys_out,
+      const value_t* values_in,
+      value_t* values_out,
+      int num_segments,
+      int num_elements,
+      int padded_n)
+      : keys_in_(keys_in),
+        keys_out_(keys_out),
+        values_in_(values_in),
+        values_out_(values_out),
+        num_segments_(num_segments),
+        num_elements_(num_elements),
+        padded_n_(padded_n) {}
+
+ private:
+  const key_t* keys_in_;
+  key_t* keys_out_;
+  const value_t* values_in_;
+  value_t* values_out_;
+  int num_segments_;
+  int num_elements_;
+  int padded_n_;
+};
+
+template <
+    typename key_t,
+    typename value_t,
+    bool IS_DESCENDING,
+    int SUBGROUP_SIZE>
+void segmented_subgroup_bitonic_sort_pairs_kernel(
+    const key_t* keys_in,
+    key_t* keys_out,
+    const value_t* values_in,
+    value_t* values_out,
+    int num_segments,
+    int num_elements) {
+  TORCH_CHECK(num_elements <= SUBGROUP_SIZE);
+  int padded_n = 1;
+  while (padded_n < num_elements)
+    padded_n <<= 1;
+  constexpr int GROUP_SIZE = SUBGROUP_SIZE * 8;
+  int64_t num_items = (int64_t)num_segments * padded_n;
+  num_items = (num_items + GROUP_SIZE - 1) / GROUP_SIZE * GROUP_SIZE;
+  auto caller = SegmentedSubGroupBitonicSortPairsFunctor<
+      key_t,
+      value_t,
+      IS_DESCENDING,
+      SUBGROUP_SIZE>(
+      keys_in,
+      keys_out,
+      values_in,
+      values_out,
+      num_segments,
+      num_elements,
+      padded_n);
+  sycl_kernel_submit(
+      num_items, GROUP_SIZE, at::xpu::getCurrentSYCLQueue(), caller);
+}
+
 // ======================= interface =======================
 
-// NOTE: Subgroup size of 32 provides better performance currently.
-// TODO: Additional selection logic is needed to adapt to different platforms.
+enum class SegmentedSortStrategy {
+  // A sub-group sorts one or more segments in registers.
+  SUBGROUP_BITONIC,
+  // A work-group sorts a segment in a single SLM tile.
+  GROUP_RADIX,
+  // All work-groups sort a segment, a pass through memory per digit.
+  DEVICE_RADIX,
+};
+
+// Longest segment the sub-group bitonic sort handles on the current device.
+inline int segmented_sort_bitonic_max_elements() {
+  if (syclHasSubGroupSize(32))
+    return 32;
+  if (syclHasSubGroupSize(16))
+    return 16;
+  return 0;
+}
+
+// Longest segment a single group radix tile holds. Wide key-value pairs use
+// half the keys per work-item to limit register pressure.
+inline int segmented_sort_group_max_elements(int key_bytes, int value_bytes) {
+  return key_bytes * value_bytes >= 64 ? 2048 : 4096;
+}
+
+// PYTORCH_XPU_SORT_STRATEGY=bitonic|group|device forces a strategy wherever it
+// can handle the segment length, for calibration with
+// examples/bench_segmented_sort.py.
+inline c10::optional<SegmentedSortStrategy> segmented_sort_strategy_override() {
+  static const c10::optional<SegmentedSortStrategy> strategy =
+      []() -> c10::optional<SegmentedSortStrategy> {
+    const char* env = std::getenv("PYTORCH_XPU_SORT_STRATEGY");
+    if (env == nullptr)
+      return c10::nullopt;
+    std::string name(env);
+    if (name == "bitonic")
+      return SegmentedSortStrategy::SUBGROUP_BITONIC;
+    if (name == "group")
+      return SegmentedSortStrategy::GROUP_RADIX;
+    if (name == "device")
+      return SegmentedSortStrategy::DEVICE_RADIX;
+    TORCH_WARN_ONCE(
+        "Ignoring PYTORCH_XPU_SORT_STRATEGY=",
+        name,
+        ", expected one of bitonic, group or device");
+    return c10::nullopt;
+  }();
+  return strategy;
+}
+
+// Elements of a device radix tile, the radix sorts run 512 work-items with 4
+// keys each, or 2 for wide key-value pairs.
+inline int segmented_sort_device_tile_elements(int key_bytes, int value_bytes) {
+  return key_bytes * value_bytes >= 64 ? 1024 : 2048;
+}
+
+// The bitonic sort takes segments up to a sub-group, packing several short
+// segments into each. Up to a group tile, the group radix sort runs one
+// work-group per segment. When there are fewer segments than the device has
+// room for such work-groups, a segment spanning several device radix tiles
+// is sorted by the device radix sort instead, which spreads it over a
+// work-group per tile. Beyond a group tile, whose size depends on the key and
+// value width, only the device radix sort applies. The group and device radix
+// tile sizes are those used before the selector; rerun
+// examples/bench_segmented_sort.py before changing them.
+inline SegmentedSortStrategy segmented_sort_strategy(
+    int64_t num_segments,
+    int64_t num_elements,
+    int key_bytes,
+    int value_bytes) {
+  int bitonic_max = segmented_sort_bitonic_max_elements();
+  int group_max = segmented_sort_group_max_elements(key_bytes, value_bytes);
+  auto forced = segmented_sort_strategy_override();
+  if (forced.has_value()) {
+    switch (*forced) {
+      case SegmentedSortStrategy::SUBGROUP_BITONIC:
+        if (num_elements <= bitonic_max)
+          return *forced;
+        break;
+      case SegmentedSortStrategy::GROUP_RADIX:
+        if (num_elements <= group_max)
+          return *forced;
+        break;
+      case SegmentedSortStrategy::DEVICE_RADIX:
+        return *forced;
+    }
+  }
+  if (num_elements <= bitonic_max)
+    return SegmentedSortStrategy::SUBGROUP_BITONIC;
+  if (num_elements > group_max)
+    return SegmentedSortStrategy::DEVICE_RADIX;
+  // Work-groups of the largest group radix tile the device runs at once.
+  int64_t group_slots = std::max<int64_t>(1, syclMaxWorkItemsPerTile() / 1024);
+  int device_tile = segmented_sort_device_tile_elements(key_bytes, value_bytes);
+  if (num_segments < group_slots && num_elements > device_tile)
+    return SegmentedSortStrategy::DEVICE_RADIX;
+  return SegmentedSortStrategy::GROUP_RADIX;
+}
+
+// Subgroup size of 32 provides better performance for the radix sorts on
+// current platforms, the bitonic sort uses the widest supported sub-group.
 template <
     typename key_t,
     typename value_t,
@@ -536,13 +804,30 @@ void segmented_sort_pairs_(
     const value_t* values_in,
     value_t* values_out,
     int num_segments,
-    int num_elements) {
+    int num_elements,
+    int end_bit) {
   constexpr int scaling_coef = sizeof(key_t) * sizeof(value_t) >= 64
       ? 2
       : 1; // Attempt to reduce register pressure for performance.
-  if (num_elements > 4096 / scaling_coef) {
-    // Considering register pressure, we use a problem size of 4096 to delineate
-    // the boundary between single tile sort and group sort.
+  auto strategy = segmented_sort_strategy(
+      num_segments, num_elements, sizeof(key_t), sizeof(value_t));
+  if (strategy == SegmentedSortStrategy::SUBGROUP_BITONIC) {
+    if (num_elements <= 16 && !syclHasSubGroupSize(32)) {
+      segmented_subgroup_bitonic_sort_pairs_kernel<
+          key_t,
+          value_t,
+          IS_DESCENDING,
+          16>(
+          keys_in, keys_out, values_in, values_out, num_segments, num_elements);
+    } else {
+      segmented_subgroup_bitonic_sort_pairs_kernel<
+          key_t,
+          value_t,
+          IS_DESCENDING,
+          32>(
+          keys_in, keys_out, values_in, values_out, num_segments, num_elements);
+    }
+  } else if (strategy == SegmentedSortStrategy::DEVICE_RADIX) {
     segmented_radix_sort_pairs_kernel<
         key_t,
         value_t,
@@ -550,7 +835,13 @@ void segmented_sort_pairs_(
         4 / scaling_coef,
         512,
         SUBGROUP_SIZE>(
-        keys_in, keys_out, values_in, values_out, num_segments, num_elements);
+        keys_in,
+        keys_out,
+        values_in,
+        values_out,
+        num_segments,
+        num_elements,
+        end_bit);
   } else if (num_elements > 2048 / scaling_coef) {
     segmented_group_radix_sort_pairs_kernel<
         key_t,
@@ -559,7 +850,13 @@ void segmented_sort_pairs_(
         4 / scaling_coef,
         1024,
         SUBGROUP_SIZE>(
-        keys_in, keys_out, values_in, values_out, num_segments, num_elements);
+        keys_in,
+        keys_out,
+        values_in,
+        values_out,
+        num_segments,
+        num_elements,
+        end_bit);
   } else if (num_elements > 1024 / scaling_coef) {
     segmented_group_radix_sort_pairs_kernel<
         key_t,
@@ -568,7 +865,13 @@ void segmented_sort_pairs_(
         4 / scaling_coef,
         512,
         SUBGROUP_SIZE>(
-        keys_in, keys_out, values_in, values_out, num_segments, num_elements);
+        keys_in,
+        keys_out,
+        values_in,
+        values_out,
+        num_segments,
+        num_elements,
+        end_bit);
   } else if (num_elements > 512 / scaling_coef) {
     segmented_group_radix_sort_pairs_kernel<
         key_t,
@@ -577,7 +880,13 @@ void segmented_sort_pairs_(
         4 / scaling_coef,
         256,
         SUBGROUP_SIZE>(
-        keys_in, keys_out, values_in, values_out, num_segments, num_elements);
+        keys_in,
+        keys_out,
+        values_in,
+        values_out,
+        num_segments,
+        num_elements,
+        end_bit);
   } else if (num_elements > 256 / scaling_coef) {
     segmented_group_radix_sort_pairs_kernel<
         key_t,
@@ -586,7 +895,13 @@ void segmented_sort_pairs_(
         4 / scaling_coef,
         128,
         SUBGROUP_SIZE>(
-        keys_in, keys_out, values_in, values_out, num_segments, num_elements);
+        keys_in,
+        keys_out,
+        values_in,
+        values_out,
+        num_segments,
+        num_elements,
+        end_bit);
   } else {
     segmented_group_radix_sort_pairs_kernel<
         key_t,
@@ -595,10 +910,19 @@ void segmented_sort_pairs_(
         4 / scaling_coef,
         64,
         SUBGROUP_SIZE>(
-        keys_in, keys_out, values_in, values_out, num_segments, num_elements);
+        keys_in,
+        keys_out,
+        values_in,
+        values_out,
+        num_segments,
+        num_elements,
+        end_bit);
   }
 }
 
+// Only key bits [0, end_bit) are sorted, so keys must agree on the higher
+// bits of their KeyTraits representation, e.g. non-negative integral keys
+// below 2^n can be sorted with end_bit = n.
 template <typename key_t, typename value_t>
 void segmented_sort_pairs(
     const key_t* keys_in,
@@ -607,13 +931,26 @@ void segmented_sort_pairs(
     value_t* values_out,
     int num_segments,
     int num_elements,
-    bool descending) {
+    bool descending,
+    int end_bit = KeyTraits<key_t>::endbit()) {
   if (descending)
     segmented_sort_pairs_<key_t, value_t, true>(
-        keys_in, keys_out, values_in, values_out, num_segments, num_elements);
+        keys_in,
+        keys_out,
+        values_in,
+        values_out,
+        num_segments,
+        num_elements,
+        end_bit);
   else
     segmented_sort_pairs_<key_t, value_t, false>(
-        keys_in, keys_out, values_in, values_out, num_segments, num_elements);
+        keys_in,
+        keys_out,
+        values_in,
+        values_out,
+        num_segments,
+        num_elements,
+        end_bit);
 }
 
 template <typename key_t, typename value_t>
@@ -623,9 +960,17 @@ void sort_pairs(
     const value_t* values_in,
     value_t* values_out,
     int num_elements,
-    bool descending) {
+    bool descending,
+    int end_bit = KeyTraits<key_t>::endbit()) {
   segmented_sort_pairs<key_t, value_t>(
-      keys_in, keys_out, values_in, values_out, 1, num_elements, descending);
+      keys_in,
+      keys_out,
+      values_in,
+      values_out,
+      1,
+      num_elements,
+      descending,
+      end_bit);
 }
 
 inline uint64_t radix_select_last_power2(uint64_t n) {
@@ -651,7 +996,8 @@ void segmented_group_select_pairs_(
     value_t* values_out,
     int num_segments,
     int num_elements,
-    int k) {
+    int k,
+    int num_chunks) {
 #define RUN_RADIX_SELECT(PADDED_N)   \
   {                                  \
     group_radix_select_pairs_kernel< \
@@ -667,11 +1013,13 @@ void segmented_group_select_pairs_(
         values_out,                  \
         num_segments,                \
         num_elements,                \
-        k);                          \
+        k,                           \
+        num_chunks);                 \
   }
   constexpr int max_group_size = 1024; // simd32-specific
-  if (num_elements <= max_group_size * 4) {
-    switch (radix_select_last_power2(num_elements)) {
+  int chunk_size = num_elements / num_chunks;
+  if (chunk_size <= max_group_size * 4) {
+    switch (radix_select_last_power2(chunk_size)) {
       case 4096:
         RUN_RADIX_SELECT(4096); // gsz 1024
         break;
@@ -704,6 +1052,10 @@ void segmented_group_select_pairs_(
 #undef RUN_RADIX_SELECT
 }
 
+// Selects the top k of each segment. With num_chunks > 1 each segment is
+// split into num_chunks chunks, the last one taking the remainder, whose top k
+// are selected by separate work-groups into keys_out[(seg * num_chunks +
+// chunk) * k]. Generated values are then indices relative to the chunk.
 template <typename key_t, typename value_t>
 void segmented_group_select_pairs(
     const key_t* keys_in,
@@ -713,7 +1065,8 @@ void segmented_group_select_pairs(
     int num_segments,
     int num_elements,
     int k,
-    bool largest) {
+    bool largest,
+    int num_chunks = 1) {
   if (largest)
     segmented_group_select_pairs_<key_t, value_t, true>(
         keys_in,
@@ -722,7 +1075,8 @@ void segmented_group_select_pairs(
         values_out,
         num_segments,
         num_elements,
-        k);
+        k,
+        num_chunks);
   else
     segmented_group_select_pairs_<key_t, value_t, false>(
         keys_in,
@@ -731,7 +1085,8 @@ void segmented_group_select_pairs(
         values_out,
         num_segments,
         num_elements,
-        k);
+        k,
+        num_chunks);
 }
 
 } // namespace xpu
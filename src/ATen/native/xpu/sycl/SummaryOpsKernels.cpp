@@ -6,6 +6,8 @@
 
 #include <ATen/AccumulateType.h>
 #include <ATen/native/xpu/sycl/Atomics.h>
+#include <ATen/ops/aminmax.h>
+#include <ATen/ops/stack.h>
 #include <comm/Runtime.h>
 #include <comm/SYCLHelpers.h>
 #include <comm/TensorInfo.h>
@@ -196,9 +198,15 @@ Tensor bincount_template(
   if (self.dim() == 1 && self.numel() == 0) {
     return at::zeros({minlength}, device(kXPU).dtype(kLong));
   }
-  if (self.dim() != 1 ||
-      (!std::is_same<input_t, uint8_t>::value &&
-       *self.min().cpu().data_ptr<input_t>() < 0)) {
+  if (self.dim() != 1) {
+    TORCH_CHECK(0, "bincount only supports 1-d non-negative integral inputs.");
+  }
+  // Both extrema in one pass over self and one copy to host
+  auto extrema = at::aminmax(self);
+  auto bounds = at::stack({std::get<0>(extrema), std::get<1>(extrema)}).cpu();
+  const input_t self_min = bounds.data_ptr<input_t>()[0];
+  const input_t self_max = bounds.data_ptr<input_t>()[1];
+  if (!std::is_same<input_t, uint8_t>::value && self_min < 0) {
     TORCH_CHECK(0, "bincount only supports 1-d non-negative integral inputs.");
   }
 
@@ -208,7 +216,7 @@ Tensor bincount_template(
   }
 
   const int64_t nbins =
-      std::max(self.max().item<input_t>() + (int64_t)1, minlength);
+      std::max(self_max + (int64_t)1, minlength);
   using bounds_t = at::acc_type_device<input_t, kXPU>;
   const bounds_t min_value = 0;
   const bounds_t max_value = nbins;
@@ -1,7 +1,9 @@
 #include <ATen/ATen.h>
 #include <ATen/Dispatch.h>
 #include <ATen/MemoryOverlap.h>
+#include <ATen/ceil_div.h>
 #include <ATen/native/TensorIterator.h>
+#include <ATen/native/xpu/sycl/Atomics.h>
 #include <ATen/native/xpu/sycl/Sorting.h>
 #include <ATen/native/xpu/sycl/SortingKernels.h>
 
@@ -9,18 +11,449 @@ namespace at {
 namespace native {
 namespace xpu {
 
-void topk_out_with_sort(
-    const Tensor& self,
+// ======================= multi-group radix select =======================
+//
+// Rows longer than a work-group tile, or k beyond what
+// segmented_group_select_pairs keeps in SLM, are selected by all work-groups
+// of a row at once. The k-th key is searched digit by digit from the MSB:
+//   1. RadixSelectHistogramFunctor counts the digits of the keys matching the
+//      prefix found so far,
+//   2. RadixSelectFindDigitFunctor picks the digit holding the k-th key and
+//      appends it to the prefix.
+// After the last digit the prefix is the k-th key. RadixSelectCountFunctor
+// counts the keys ahead of and equal to it per work-group and
+// RadixSelectGatherFunctor compacts them to the output in index order.
+
+constexpr int RADIX_SELECT_BITS = 8;
+constexpr int RADIX_SELECT_BUCKETS = 1 << RADIX_SELECT_BITS;
+constexpr int RADIX_SELECT_GROUP_SIZE = RADIX_SELECT_BUCKETS;
+// Elements per work-group below which rows are not split further.
+constexpr int RADIX_SELECT_MIN_CHUNK = RADIX_SELECT_GROUP_SIZE * 16;
+
+template <typename KeyTraitsT>
+struct RadixSelectState {
+  KeyTraitsT desired;
+  KeyTraitsT desired_mask;
+  // Number of keys equal to the prefix still to be selected.
+  int k_to_find;
+};
+
+template <typename scalar_t>
+struct RadixSelectHistogramFunctor : public __SYCL_KER_CONFIG_CONVENTION__ {
+  using KeyTraitsT = typename KeyTraits<scalar_t>::Type;
+
+  void operator()(sycl::nd_item<1> item) const {
+    int lid = item.get_local_id(0);
+    int64_t seg = item.get_group(0) / blocks_per_seg_;
+    int64_t blk = item.get_group(0) % blocks_per_seg_;
+    for (int i = lid; i < RADIX_SELECT_BUCKETS; i += RADIX_SELECT_GROUP_SIZE) {
+      hist_[i] = 0;
+    }
+    KeyTraitsT desired = 0;
+    KeyTraitsT desired_mask = 0;
+    if (pass_ > 0) {
+      desired = states_[seg].desired;
+      desired_mask = states_[seg].desired_mask;
+    }
+    item.barrier(sycl_local_fence);
+
+    const scalar_t* keys = keys_ + seg * nelements_;
+    int64_t end = std::min(nelements_, (blk + 1) * chunk_);
+    for (int64_t i = blk * chunk_ + lid; i < end;
+         i += RADIX_SELECT_GROUP_SIZE) {
+      KeyTraitsT ukey = KeyTraits<scalar_t>::convert(c10::load(&keys[i]));
+      if ((ukey & desired_mask) == desired) {
+        int digit = (ukey >> shift_) & (RADIX_SELECT_BUCKETS - 1);
+        sycl_atomic_ref_rlx_wg_local_t<int> target(hist_[digit]);
+        target.fetch_add(1);
+      }
+    }
+    item.barrier(sycl_local_fence);
+
+    for (int i = lid; i < RADIX_SELECT_BUCKETS; i += RADIX_SELECT_GROUP_SIZE) {
+      if (hist_[i] > 0) {
+        atomicAdd(
+            sycl_global_ptr<int>(&counts_[seg * RADIX_SELECT_BUCKETS + i]),
+            hist_[i]);
+      }
+    }
+  }
+
+  void sycl_ker_config_convention(sycl::handler& cgh) {
+    hist_ = sycl_local_acc_t<int>(RADIX_SELECT_BUCKETS, cgh);
+  }
+
+  RadixSelectHistogramFunctor(
+      const scalar_t* keys,
+      int* counts,
+      const RadixSelectState<KeyTraitsT>* states,
+      int64_t nelements,
+      int64_t blocks_per_seg,
+      int64_t chunk,
+      int pass,
+      int shift)
+      : keys_(keys),
+        counts_(counts),
+        states_(states),
+        nelements_(nelements),
+        blocks_per_seg_(blocks_per_seg),
+        chunk_(chunk),
+        pass_(pass),
+        shift_(shift) {}
+
+ private:
+  const scalar_t* keys_;
+  int* counts_;
+  const RadixSelectState<KeyTraitsT>* states_;
+  int64_t nelements_;
+  int64_t blocks_per_seg_;
+  int64_t chunk_;
+  int pass_;
+  int shift_;
+  sycl_local_acc_t<int> hist_;
+};
+
+template <typename scalar_t>
+struct RadixSelectFindDigitFunctor {
+  using KeyTraitsT = typename KeyTraits<scalar_t>::Type;
+
+  void operator()(sycl::nd_item<1> item) const {
+    int64_t seg = item.get_group(0);
+    int lid = item.get_local_id(0);
+    // Scan the buckets in selection order, the k-th key lies in the bucket
+    // where the running count reaches k.
+    int digit = largest_ ? RADIX_SELECT_BUCKETS - 1 - lid : lid;
+    int count = counts_[seg * RADIX_SELECT_BUCKETS + digit];
+    RadixSelectState<KeyTraitsT> state{0, 0, k_};
+    if (pass_ > 0) {
+      state = states_[seg];
+    }
+    int inclusive = sycl::inclusive_scan_over_group(
+        item.get_group(), count, sycl::plus<int>());
+    int exclusive = inclusive - count;
+    if (exclusive < state.k_to_find && inclusive >= state.k_to_find) {
+      state.desired |= static_cast<KeyTraitsT>(digit) << shift_;
+      state.desired_mask |= static_cast<KeyTraitsT>(RADIX_SELECT_BUCKETS - 1)
+          << shift_;
+      state.k_to_find -= exclusive;
+      states_[seg] = state;
+    }
+  }
+
+  RadixSelectFindDigitFunctor(
+      const int* counts,
+      RadixSelectState<KeyTraitsT>* states,
+      int k,
+      int pass,
+      int shift,
+      bool largest)
+      : counts_(counts),
+        states_(states),
+        k_(k),
+        pass_(pass),
+        shift_(shift),
+        largest_(largest) {}
+
+ private:
+  const int* counts_;
+  RadixSelectState<KeyTraitsT>* states_;
+  int k_;
+  int pass_;
+  int shift_;
+  bool largest_;
+};
+
+template <typename KeyTraitsT>
+inline bool radix_select_ahead(KeyTraitsT ukey, KeyTraitsT kth, bool largest) {
+  return largest ? ukey > kth : ukey < kth;
+}
+
+template <typename scalar_t>
+struct RadixSelectCountFunctor {
+  using KeyTraitsT = typename KeyTraits<scalar_t>::Type;
+
+  void operator()(sycl::nd_item<1> item) const {
+    int lid = item.get_local_id(0);
+    int64_t seg = item.get_group(0) / blocks_per_seg_;
+    int64_t blk = item.get_group(0) % blocks_per_seg_;
+    KeyTraitsT kth = states_[seg].desired;
+
+    const scalar_t* keys = keys_ + seg * nelements_;
+    int64_t end = std::min(nelements_, (blk + 1) * chunk_);
+    int ahead = 0;
+    int equal = 0;
+    for (int64_t i = blk * chunk_ + lid; i < end;
+         i += RADIX_SELECT_GROUP_SIZE) {
+      KeyTraitsT ukey = KeyTraits<scalar_t>::convert(c10::load(&keys[i]));
+      ahead += radix_select_ahead(ukey, kth, largest_);
+      equal += ukey == kth;
+    }
+    ahead = sycl::reduce_over_group(item.get_group(), ahead, sycl::plus<int>());
+    equal = sycl::reduce_over_group(item.get_group(), equal, sycl::plus<int>());
+    if (lid == 0) {
+      block_counts_[item.get_group(0) * 2] = ahead;
+      block_counts_[item.get_group(0) * 2 + 1] = equal;
+    }
+  }
+
+  RadixSelectCountFunctor(
+      const scalar_t* keys,
+      int* block_counts,
+      const RadixSelectState<KeyTraitsT>* states,
+      int64_t nelements,
+      int64_t blocks_per_seg,
+      int64_t chunk,
+      bool largest)
+      : keys_(keys),
+        block_counts_(block_counts),
+        states_(states),
+        nelements_(nelements),
+        blocks_per_seg_(blocks_per_seg),
+        chunk_(chunk),
+        largest_(largest) {}
+
+ private:
+  const scalar_t* keys_;
+  int* block_counts_;
+  const RadixSelectState<KeyTraitsT>* states_;
+  int64_t nelements_;
+  int64_t blocks_per_seg_;
+  int64_t chunk_;
+  bool largest_;
+};
+
+template <typename scalar_t>
+struct RadixSelectGatherFunctor {
+  using KeyTraitsT = typename KeyTraits<scalar_t>::Type;
+
+  void operator()(sycl::nd_item<1> item) const {
+    int lid = item.get_local_id(0);
+    int64_t seg = item.get_group(0) / blocks_per_seg_;
+    int64_t blk = item.get_group(0) % blocks_per_seg_;
+    KeyTraitsT kth = states_[seg].desired;
+    int k_to_find = states_[seg].k_to_find;
+
+    // Output offsets of this work-group are the counts of the preceding
+    // work-groups of the row. Keys ahead of the k-th key take the first
+    // k - k_to_find slots, the first k_to_find keys equal to it the rest.
+    int ahead_offset = 0;
+    int equal_offset = 0;
+    const int* row_counts = block_counts_ + seg * blocks_per_seg_ * 2;
+    for (int64_t b = lid; b < blk; b += RADIX_SELECT_GROUP_SIZE) {
+      ahead_offset += row_counts[b * 2];
+      equal_offset += row_counts[b * 2 + 1];
+    }
+    ahead_offset = sycl::reduce_over_group(
+        item.get_group(), ahead_offset, sycl::plus<int>());
+    equal_offset = sycl::reduce_over_group(
+        item.get_group(), equal_offset, sycl::plus<int>());
+
+    const scalar_t* keys = keys_ + seg * nelements_;
+    scalar_t* values = values_ + seg * k_;
+    int64_t* indices = indices_ + seg * k_;
+    int64_t begin = blk * chunk_;
+    int64_t end = std::min(nelements_, (blk + 1) * chunk_);
+    for (int64_t base = begin; base < end; base += RADIX_SELECT_GROUP_SIZE) {
+      int64_t i = base + lid;
+      scalar_t key;
+      bool is_ahead = false;
+      bool is_equal = false;
+      if (i < end) {
+        key = c10::load(&keys[i]);
+        KeyTraitsT ukey = KeyTraits<scalar_t>::convert(key);
+        is_ahead = radix_select_ahead(ukey, kth, largest_);
+        is_equal = ukey == kth;
+      }
+      int ahead_pos = sycl::exclusive_scan_over_group(
+          item.get_group(), (int)is_ahead, sycl::plus<int>());
+      int equal_pos = sycl::exclusive_scan_over_group(
+          item.get_group(), (int)is_equal, sycl::plus<int>());
+      if (is_ahead) {
+        int pos = ahead_offset + ahead_pos;
+        values[pos] = key;
+        indices[pos] = i;
+      } else if (is_equal && equal_offset + equal_pos < k_to_find) {
+        int pos = k_ - k_to_find + equal_offset + equal_pos;
+        values[pos] = key;
+        indices[pos] = i;
+      }
+      ahead_offset += sycl::reduce_over_group(
+          item.get_group(), (int)is_ahead, sycl::plus<int>());
+      equal_offset += sycl::reduce_over_group(
+          item.get_group(), (int)is_equal, sycl::plus<int>());
+    }
+  }
+
+  RadixSelectGatherFunctor(
+      const scalar_t* keys,
+      scalar_t* values,
+      int64_t* indices,
+      const int* block_counts,
+      const RadixSelectState<KeyTraitsT>* states,
+      int64_t nelements,
+      int64_t k,
+      int64_t blocks_per_seg,
+      int64_t chunk,
+      bool largest)
+      : keys_(keys),
+        values_(values),
+        indices_(indices),
+        block_counts_(block_counts),
+        states_(states),
+        nelements_(nelements),
+        k_(k),
+        blocks_per_seg_(blocks_per_seg),
+        chunk_(chunk),
+        largest_(largest) {}
+
+ private:
+  const scalar_t* keys_;
+  scalar_t* values_;
+  int64_t* indices_;
+  const int* block_counts_;
+  const RadixSelectState<KeyTraitsT>* states_;
+  int64_t nelements_;
+  int64_t k_;
+  int64_t blocks_per_seg_;
+  int64_t chunk_;
+  bool largest_;
+};
+
+// Work-groups that keep the device busy, spread over the rows.
+inline int64_t topk_groups_per_segment(int64_t nsegments, int64_t nelements) {
+  int64_t max_groups = syclMaxWorkItemsPerTile() / RADIX_SELECT_GROUP_SIZE;
+  int64_t groups = std::min(
+      ceil_div(nelements, (int64_t)RADIX_SELECT_MIN_CHUNK),
+      ceil_div(max_groups, nsegments));
+  return std::max(groups, (int64_t)1);
+}
+
+// Unsorted top k of each contiguous row of keys, for any k <= nelements.
+template <typename scalar_t>
+void radix_select_topk(
+    const scalar_t* keys,
+    scalar_t* values,
+    int64_t* indices,
+    int64_t nsegments,
+    int64_t nelements,
     int64_t k,
-    int64_t dim,
     bool largest,
-    const Tensor& values,
-    const Tensor& indices) {
-  Tensor sorted_values, sorted_indices;
-  std::tie(sorted_values, sorted_indices) =
-      at::sort(self, /* stable= */ false, dim, largest);
-  values.copy_(sorted_values.narrow(dim, 0, k));
-  indices.copy_(sorted_indices.narrow(dim, 0, k));
+    const TensorOptions& options) {
+  using KeyTraitsT = typename KeyTraits<scalar_t>::Type;
+  auto& q = getCurrentSYCLQueue();
+
+  int64_t blocks_per_seg = topk_groups_per_segment(nsegments, nelements);
+  int64_t chunk = ceil_div(nelements, blocks_per_seg);
+  chunk = ceil_div(chunk, (int64_t)RADIX_SELECT_GROUP_SIZE) *
+      RADIX_SELECT_GROUP_SIZE;
+  blocks_per_seg = ceil_div(nelements, chunk);
+  int64_t ngroups = nsegments * blocks_per_seg;
+
+  const int num_passes = KeyTraits<scalar_t>::endbit() / RADIX_SELECT_BITS;
+  auto opts = options.dtype(kInt);
+  Tensor counts =
+      at::zeros({num_passes, nsegments, RADIX_SELECT_BUCKETS}, opts);
+  Tensor block_counts = at::empty({ngroups, 2}, opts);
+  Tensor states = at::empty(
+      {nsegments * (int64_t)sizeof(RadixSelectState<KeyTraitsT>)},
+      opts.dtype(kByte));
+  auto states_ptr =
+      reinterpret_cast<RadixSelectState<KeyTraitsT>*>(states.data_ptr());
+
+  for (int pass = 0; pass < num_passes; pass++) {
+    int shift = KeyTraits<scalar_t>::endbit() - (pass + 1) * RADIX_SELECT_BITS;
+    int* pass_counts = counts[pass].data_ptr<int>();
+    sycl_kernel_submit(
+        ngroups * RADIX_SELECT_GROUP_SIZE,
+        RADIX_SELECT_GROUP_SIZE,
+        q,
+        RadixSelectHistogramFunctor<scalar_t>(
+            keys,
+            pass_counts,
+            states_ptr,
+            nelements,
+            blocks_per_seg,
+            chunk,
+            pass,
+            shift));
+    sycl_kernel_submit(
+        nsegments * RADIX_SELECT_BUCKETS,
+        RADIX_SELECT_BUCKETS,
+        q,
+        RadixSelectFindDigitFunctor<scalar_t>(
+            pass_counts, states_ptr, k, pass, shift, largest));
+  }
+
+  sycl_kernel_submit(
+      ngroups * RADIX_SELECT_GROUP_SIZE,
+      RADIX_SELECT_GROUP_SIZE,
+      q,
+      RadixSelectCountFunctor<scalar_t>(
+          keys,
+          block_counts.data_ptr<int>(),
+          states_ptr,
+          nelements,
+          blocks_per_seg,
+          chunk,
+          largest));
+  sycl_kernel_submit(
+      ngroups * RADIX_SELECT_GROUP_SIZE,
+      RADIX_SELECT_GROUP_SIZE,
+      q,
+      RadixSelectGatherFunctor<scalar_t>(
+          keys,
+          values,
+          indices,
+          block_counts.const_data_ptr<int>(),
+          states_ptr,
+          nelements,
+          k,
+          blocks_per_seg,
+          chunk,
+          largest));
+}
+
+// Top k of rows too wide for a single work-group to be efficient: chunks of
+// each row are selected by separate work-groups, then the top k of their
+// candidates.
+template <typename scalar_t>
+void chunked_group_select_topk(
+    const scalar_t* keys,
+    scalar_t* values,
+    int64_t* indices,
+    int64_t nsegments,
+    int64_t nelements,
+    int64_t k,
+    int64_t nchunks,
+    bool largest,
+    const TensorOptions& options) {
+  Tensor candidate_values = at::empty({nsegments, nchunks, k}, options);
+  Tensor candidate_indices =
+      at::empty({nsegments, nchunks, k}, options.dtype(kLong));
+  segmented_group_select_pairs<scalar_t, int64_t>(
+      keys,
+      candidate_values.data_ptr<scalar_t>(),
+      nullptr,
+      candidate_indices.data_ptr<int64_t>(),
+      nsegments,
+      nelements,
+      k,
+      largest,
+      nchunks);
+  // Candidate indices are relative to their chunk.
+  int64_t chunk = nelements / nchunks;
+  candidate_indices.add_(
+      at::arange(0, nchunks * chunk, chunk, options.dtype(kLong))
+          .view({1, nchunks, 1}));
+  segmented_group_select_pairs<scalar_t, int64_t>(
+      candidate_values.const_data_ptr<scalar_t>(),
+      values,
+      candidate_indices.const_data_ptr<int64_t>(),
+      indices,
+      nsegments,
+      nchunks * k,
+      k,
+      largest);
 }
 
 std::tuple<at::Tensor&, at::Tensor&> topk_kernel(
@@ -62,11 +495,6 @@ std::tuple<at::Tensor&, at::Tensor&> topk_kernel(
   values.resize_(out_sizes);
   indices.resize_(out_sizes);
 
-  if (k > 256) { // The segmented_group_select_pairs supports k<=256
-    topk_out_with_sort(self.contiguous(), k, dim, largest, values, indices);
-    return std::forward_as_tuple(values, indices);
-  }
-
   Tensor self_;
   bool need_infer_dim = dim != ndim - 1;
   if (!need_infer_dim) {
@@ -101,15 +529,45 @@ std::tuple<at::Tensor&, at::Tensor&> topk_kernel(
         scalar_t* self_ptr = self_.data_ptr<scalar_t>();
         scalar_t* values_ptr = values_.data_ptr<scalar_t>();
         int64_t* indices_ptr = indices_.data_ptr<int64_t>();
-        segmented_group_select_pairs<scalar_t, int64_t>(
-            self_ptr,
-            (scalar_t*)values_ptr,
-            nullptr,
-            (int64_t*)indices_ptr,
-            nsegments,
-            nelements,
-            k,
-            largest);
+        // segmented_group_select_pairs keeps k <= 256 candidates in SLM and
+        // runs a work-group per row. Larger k, and long rows that would
+        // leave most of the device idle, are split over work-groups.
+        int64_t groups_per_segment =
+            topk_groups_per_segment(nsegments, nelements);
+        int64_t nchunks = std::min(
+            groups_per_segment, (int64_t)RADIX_SELECT_MIN_CHUNK / k);
+        if (k > 256) {
+          radix_select_topk<scalar_t>(
+              self_ptr,
+              values_ptr,
+              indices_ptr,
+              nsegments,
+              nelements,
+              k,
+              largest,
+              self_.options());
+        } else if (nchunks >= 4) {
+          chunked_group_select_topk<scalar_t>(
+              self_ptr,
+              values_ptr,
+              indices_ptr,
+              nsegments,
+              nelements,
+              k,
+              nchunks,
+              largest,
+              self_.options());
+        } else {
+          segmented_group_select_pairs<scalar_t, int64_t>(
+              self_ptr,
+              (scalar_t*)values_ptr,
+              nullptr,
+              (int64_t*)indices_ptr,
+              nsegments,
+              nelements,
+              k,
+              largest);
+        }
 
         if (sorted) {
           segmented_sort_pairs<scalar_t, int64_t>(
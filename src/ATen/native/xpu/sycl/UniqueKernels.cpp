@@ -25,27 +25,6 @@ struct UniqueEqualFunctor {
   }
 };
 
-template <typename index_t>
-struct ComputeInverseLTFunctor {
-  auto operator()(index_t a, index_t b) const {
-    return (a < b);
-  }
-};
-
-template <>
-struct ComputeInverseLTFunctor<float> {
-  auto operator()(float a, float b) const {
-    return (std::isless(a, b));
-  }
-};
-
-template <>
-struct ComputeInverseLTFunctor<double> {
-  auto operator()(double a, double b) const {
-    return (std::isless(a, b));
-  }
-};
-
 template <typename input_t, typename index_t, typename not_equal_t>
 Tensor compute_inverse(
     const Tensor& sorted,
@@ -78,9 +57,16 @@ Tensor compute_inverse(
         /*dim*/ 0,
         (index_t)(0.0),
         std::plus<index_t>());
-    ComputeInverseLTFunctor<index_t> f;
+    // sorted_indices is a permutation of [0, num_inp), so a radix sort over
+    // its significant bits scatters inv_loc back to input order.
     pstl::sort<index_t, index_t>(
-        sorted_indices_ptr, inv_loc_ptr, sorted_indices.size(0), f);
+        sorted_indices_ptr,
+        sorted_indices_ptr,
+        inv_loc_ptr,
+        inv_loc_ptr,
+        sorted_indices.size(0),
+        false,
+        num_inp);
     inverse_indices = inv_loc;
   }
 
@@ -6,6 +6,7 @@
 #include <ATen/native/xpu/sycl/MemoryAccess.h>
 #include <ATen/native/xpu/sycl/MemoryAccessUtils.h>
 #include <ATen/native/xpu/sycl/SortingKernels.h>
+#include <ATen/native/xpu/sycl/pstl/ScanKernels.h>
 #include <comm/SYCLContext.h>
 #include <comm/SYCLHelpers.h>
 #include <comm/TensorOptions.h>
@@ -15,158 +16,6 @@ namespace at::native::xpu::pstl {
 
 using namespace at::xpu;
 
-template <int scan_type, class InputIt, class OutputIt, class T>
-struct KSScanKernelFunctor : public __SYCL_KER_CONFIG_CONVENTION__ {
-  void operator()(sycl::nd_item<1> item_id) const {
-    auto local_id = item_id.get_local_linear_id();
-
-    // initialize local_input
-    auto cur_init = init_;
-    if (scan_type == 1) {
-      local_scan_[local_id] = first_[local_id];
-    } else {
-      if (local_id > 0)
-        local_scan_[local_id] = first_[local_id - 1];
-      else
-        local_scan_[local_id] = 0;
-    }
-    if (local_id == 0)
-      local_scan_[local_id] += cur_init;
-    item_id.barrier(sycl_local_fence);
-
-    // body of KS algo
-    for (auto __k = 1; __k < N_; __k <<= 1) {
-      auto tmp = (local_id >= __k) ? local_scan_[local_id - __k] : 0;
-      item_id.barrier(sycl_local_fence);
-      local_scan_[local_id] += tmp;
-      item_id.barrier(sycl_local_fence);
-    }
-
-    // flush result into dst
-    d_first_[local_id] = local_scan_[local_id];
-  }
-
-  void sycl_ker_config_convention(sycl::handler& cgh) {
-    local_scan_ = sycl_local_acc_t<T>(N_, cgh);
-  }
-
-  KSScanKernelFunctor(InputIt first, T init, int64_t N, OutputIt d_first)
-      : first_(first), init_(init), N_(N), d_first_(d_first), local_scan_() {}
-
- private:
-  InputIt first_;
-  T init_;
-  int64_t N_;
-  OutputIt d_first_;
-  sycl_local_acc_t<T> local_scan_;
-};
-
-template <int scan_type, class InputIt, class OutputIt, class T>
-struct KSScanWithCarrierKernelFunctor : public __SYCL_KER_CONFIG_CONVENTION__ {
-  void operator()(sycl::nd_item<1> item_id) const {
-    auto local_id = item_id.get_local_linear_id();
-    auto global_id = item_id.get_global_linear_id();
-    auto group_id = item_id.get_group_linear_id();
-
-    // initialize local_input
-    auto cur_init = (group_id == 0 ? init_ : 0);
-    if (global_id < N_) {
-      if (scan_type == 1) {
-        local_scan_[local_id] = first_[global_id];
-      } else {
-        if (local_id > 0)
-          local_scan_[local_id] = first_[global_id - 1];
-        else
-          local_scan_[local_id] = 0;
-      }
-      if (local_id == 0)
-        local_scan_[local_id] += cur_init;
-      if (local_id == wgroup_size_ - 1) {
-        carry_ptr_[group_id] = first_[global_id];
-      }
-    }
-    item_id.barrier(sycl_local_fence);
-
-    // body of KS algo
-    for (auto __k = 1; __k < wgroup_size_; __k <<= 1) {
-      auto tmp = (local_id >= __k) ? local_scan_[local_id - __k] : 0;
-      item_id.barrier(sycl_local_fence);
-      local_scan_[local_id] += tmp;
-      item_id.barrier(sycl_local_fence);
-    }
-
-    // flush result into dst
-    if (global_id < N_) {
-      d_first_[global_id] = local_scan_[local_id];
-    }
-    if (local_id == wgroup_size_ - 1) {
-      if (scan_type == 1)
-        carry_ptr_[group_id] = local_scan_[local_id];
-      else
-        carry_ptr_[group_id] += local_scan_[local_id];
-    }
-  }
-
-  void sycl_ker_config_convention(sycl::handler& cgh) {
-    local_scan_ = sycl_local_acc_t<T>(wgroup_size_, cgh);
-  }
-
-  KSScanWithCarrierKernelFunctor(
-      InputIt first,
-      T init,
-      int64_t N,
-      T* carry_ptr,
-      int64_t wgroup_size,
-      OutputIt d_first)
-      : first_(first),
-        init_(init),
-        N_(N),
-        carry_ptr_(carry_ptr),
-        wgroup_size_(wgroup_size),
-        d_first_(d_first),
-        local_scan_() {}
-
- private:
-  InputIt first_;
-  T init_;
-  int64_t N_;
-  T* carry_ptr_;
-  int64_t wgroup_size_;
-  OutputIt d_first_;
-  sycl_local_acc_t<T> local_scan_;
-};
-
-template <class OutputIt, class T>
-struct ScanAccumulateKernelFunctor : public __SYCL_KER_CONFIG_CONVENTION__ {
-  void operator()(sycl::nd_item<1> item_id) const {
-    auto local_id = item_id.get_local_linear_id();
-    auto global_id = item_id.get_global_linear_id();
-    auto group_id = item_id.get_group_linear_id();
-
-    if (local_id == 0)
-      local_carry_[0] = carry_ptr_[group_id];
-    item_id.barrier(sycl_local_fence);
-
-    if (global_id < N_) {
-      d_first_[global_id] += local_carry_[0];
-    }
-  }
-
-  void sycl_ker_config_convention(sycl::handler& cgh) {
-    local_carry_ = sycl_local_acc_t<T>(1, cgh);
-    return;
-  }
-
-  ScanAccumulateKernelFunctor(OutputIt d_first, T* carry_ptr, int64_t N)
-      : local_carry_(), d_first_(d_first), carry_ptr_(carry_ptr), N_(N) {}
-
- private:
-  sycl_local_acc_t<T> local_carry_;
-  OutputIt d_first_;
-  T* carry_ptr_;
-  int64_t N_;
-};
-
 template <int scan_type, class InputIt, class OutputIt, class T>
 static inline OutputIt _scan_kernel(
     InputIt first,
@@ -174,15 +23,13 @@ static inline OutputIt _scan_kernel(
     OutputIt d_first,
     T init) {
   using KSScanKernel = KSScanKernelFunctor<scan_type, InputIt, OutputIt, T>;
-  using KSScanWithCarrierKernel =
-      KSScanWithCarrierKernelFunctor<scan_type, InputIt, OutputIt, T>;
+  using LookBackScanKernel =
+      LookBackScanKernelFunctor<scan_type, InputIt, OutputIt, T>;
 
   const auto N = std::distance(first, last);
   auto& q = getCurrentSYCLQueue();
   const auto kss_wgroup_size = syclMaxWorkGroupSize<KSScanKernel>();
 
-  auto options = map_options<T>();
-
   if (N <= kss_wgroup_size) {
     // Kogge-Stone addr algorithm;
     KSScanKernel kfn1(first, init, N, d_first);
@@ -191,35 +38,29 @@ static inline OutputIt _scan_kernel(
     return d_first + N;
   }
 
-  const auto kssc_wgroup_size = syclMaxWorkGroupSize<KSScanWithCarrierKernel>();
-  auto ngroups = (N + kssc_wgroup_size - 1) / kssc_wgroup_size;
-  Tensor carry = at::empty({ngroups}, options);
-  T* carry_ptr = carry.data_ptr<T>();
-
-  // 1. do exclusive_scan on each workgroups
-  KSScanWithCarrierKernel kfn2(
-      first, init, N, carry_ptr, kssc_wgroup_size, d_first);
+  // Single pass decoupled look-back scan
+  const auto lbs_wgroup_size = syclMaxWorkGroupSize<LookBackScanKernel>();
+  const auto ntiles =
+      ceil_div<int64_t>(N, lbs_wgroup_size * kLookBackScanItems);
+  Tensor workspace = at::empty(
+      {static_cast<int64_t>(ScanTileState<T>::workspace_bytes(ntiles))},
+      map_options<uint8_t>());
+  void* workspace_ptr = workspace.data_ptr();
+  q.memset(workspace_ptr, 0, ScanTileState<T>::status_bytes(ntiles));
+
+  LookBackScanKernel kfn2(
+      first,
+      init,
+      N,
+      ScanTileState<T>(workspace_ptr, ntiles),
+      lbs_wgroup_size,
+      d_first);
   sycl_kernel_submit(
-      sycl::range<1>(ngroups * kssc_wgroup_size),
-      sycl::range<1>(kssc_wgroup_size),
+      sycl::range<1>(ntiles * lbs_wgroup_size),
+      sycl::range<1>(lbs_wgroup_size),
       q,
       kfn2);
 
-  // 2. recursion for carry
-  _scan_kernel<0>(carry_ptr, carry_ptr + ngroups, carry_ptr, (T)0);
-
-  // 3. reduce among all work groups and flush data to dst
-  ScanAccumulateKernelFunctor<OutputIt, T> kfn3(d_first, carry_ptr, N);
-
-  const auto sa_wgroup_size = syclMaxWorkGroupSize(kfn3);
-  ngroups = (N + sa_wgroup_size - 1) / sa_wgroup_size;
-
-  sycl_kernel_submit(
-      sycl::range<1>(ngroups * sa_wgroup_size),
-      sycl::range<1>(sa_wgroup_size),
-      q,
-      kfn3);
-
   return d_first + N;
 }
 
@@ -1429,6 +1270,57 @@ void sort(
       in_key, out_key, nullptr, out_val, sort_sz, descending);
 }
 
+// Number of low key bits a radix sort processes for integral keys known to
+// lie in [0, key_range).
+template <typename KeyType>
+inline int radix_sort_end_bit(int64_t key_range) {
+  int end_bit = 1;
+  while (end_bit < KeyTraits<KeyType>::endbit() &&
+         (uint64_t)(key_range - 1) >> end_bit) {
+    end_bit++;
+  }
+  return end_bit;
+}
+
+// sort (in_key, out_key, in_val, out_val, sort_sz, descending, key_range)
+// Integral keys in [0, key_range), e.g. indices into a tensor of known size.
+// Only the significant bits of the keys are sorted, so the number of radix
+// passes drops from sizeof(KeyType) * 2 to ceil(log2(key_range) / 4).
+// in_val: values to be permuted, indices [0, 1, 2, ...] are used if nullptr
+template <typename KeyType, typename ValueType>
+void sort(
+    const KeyType* in_key,
+    KeyType* out_key,
+    const ValueType* in_val,
+    ValueType* out_val,
+    const int64_t sort_sz,
+    bool descending,
+    int64_t key_range) {
+  static_assert(
+      std::is_integral_v<KeyType>, "pstl::sort: key_range needs integral keys");
+  RECORD_FUNCTION("pstl::sort", {});
+  sort_pairs<KeyType, ValueType>(
+      in_key,
+      out_key,
+      in_val,
+      out_val,
+      sort_sz,
+      descending,
+      radix_sort_end_bit<KeyType>(key_range));
+}
+
+template <typename KeyType, typename ValueType>
+void sort(
+    const KeyType* in_key,
+    KeyType* out_key,
+    ValueType* out_val,
+    const int64_t sort_sz,
+    bool descending,
+    int64_t key_range) {
+  sort<KeyType, ValueType>(
+      in_key, out_key, nullptr, out_val, sort_sz, descending, key_range);
+}
+
 template <class T, class ForwardIt>
 struct IotaKernelFunctor {
   void operator()(sycl::item<1> item_id) const {
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <comm/SYCLHelpers.h>
+
+// Scan kernels of pstl::inclusive_scan/exclusive_scan. They only depend on
+// SYCL, so that they can be benchmarked standalone.
+
+namespace at::native::xpu::pstl {
+
+template <int scan_type, class InputIt, class OutputIt, class T>
+struct KSScanKernelFunctor : public __SYCL_KER_CONFIG_CONVENTION__ {
+  void operator()(sycl::nd_item<1> item_id) const {
+    auto local_id = item_id.get_local_linear_id();
+
+    // initialize local_input
+    auto cur_init = init_;
+    if (scan_type == 1) {
+      local_scan_[local_id] = first_[local_id];
+    } else {
+      if (local_id > 0)
+        local_scan_[local_id] = first_[local_id - 1];
+      else
+        local_scan_[local_id] = 0;
+    }
+    if (local_id == 0)
+      local_scan_[local_id] += cur_init;
+    item_id.barrier(sycl_local_fence);
+
+    // body of KS algo
+    for (auto __k = 1; __k < N_; __k <<= 1) {
+      auto tmp = (local_id >= __k) ? local_scan_[local_id - __k] : 0;
+      item_id.barrier(sycl_local_fence);
+      local_scan_[local_id] += tmp;
+      item_id.barrier(sycl_local_fence);
+    }
+
+    // flush result into dst
+    d_first_[local_id] = local_scan_[local_id];
+  }
+
+  void sycl_ker_config_convention(sycl::handler& cgh) {
+    local_scan_ = sycl_local_acc_t<T>(N_, cgh);
+  }
+
+  KSScanKernelFunctor(InputIt first, T init, int64_t N, OutputIt d_first)
+      : first_(first), init_(init), N_(N), d_first_(d_first), local_scan_() {}
+
+ private:
+  InputIt first_;
+  T init_;
+  int64_t N_;
+  OutputIt d_first_;
+  sycl_local_acc_t<T> local_scan_;
+};
+
+// Single-pass scan with decoupled look-back (Merrill and Garland, 2016).
+// Each work group scans a tile of `wg_size * kLookBackScanItems` elements and
+// publishes the tile aggregate, then resolves its exclusive prefix by walking
+// back over the status of preceding tiles until it finds an inclusive prefix.
+// Input and output are touched once, and no carry buffers are needed.
+static constexpr int kLookBackScanItems = 4;
+
+static constexpr uint32_t kScanTileInvalid = 0;
+static constexpr uint32_t kScanTileAggregate = 1;
+static constexpr uint32_t kScanTilePrefix = 2;
+
+// Workspace of the look-back scan. `status` holds one flag per tile, followed
+// by the counter handing out tile ids, and must be zeroed before each launch.
+template <typename T>
+struct ScanTileState {
+  static size_t status_bytes(int64_t ntiles) {
+    // Keep the tile values aligned to 16 bytes.
+    return (((ntiles + 1) * sizeof(uint32_t) + 15) / 16) * 16;
+  }
+
+  static size_t workspace_bytes(int64_t ntiles) {
+    return status_bytes(ntiles) + 2 * ntiles * sizeof(T);
+  }
+
+  ScanTileState(void* workspace, int64_t ntiles)
+      : status(static_cast<uint32_t*>(workspace)),
+        tile_counter(status + ntiles),
+        aggregates(reinterpret_cast<T*>(
+            static_cast<char*>(workspace) + status_bytes(ntiles))),
+        prefixes(aggregates + ntiles) {}
+
+  uint32_t* status;
+  uint32_t* tile_counter;
+  T* aggregates;
+  T* prefixes;
+};
+
+template <int scan_type, class InputIt, class OutputIt, class T>
+struct LookBackScanKernelFunctor : public __SYCL_KER_CONFIG_CONVENTION__ {
+  using status_ref_t = sycl::atomic_ref<
+      uint32_t,
+      sycl_mem_odr_acq_rel,
+      sycl_mem_scp_dev,
+      sycl_global_space>;
+
+  void operator()(sycl::nd_item<1> item_id) const {
+    auto group = item_id.get_group();
+    const int64_t local_id = item_id.get_local_linear_id();
+    const int64_t wg_size = item_id.get_local_range(0);
+    const int64_t tile_size = wg_size * kLookBackScanItems;
+
+    // Tile ids follow the order in which groups start, so a group only waits
+    // on groups that are already running.
+    if (local_id == 0) {
+      status_ref_t counter(*state_.tile_counter);
+      local_tile_id_[0] = counter.fetch_add(1u, sycl_mem_odr_rlx);
+    }
+    item_id.barrier(sycl_local_fence);
+    const int64_t tile_id = local_tile_id_[0];
+    const int64_t tile_start = tile_id * tile_size;
+
+    // Coalesced loads, then each work item scans consecutive elements.
+#pragma unroll
+    for (int i = 0; i < kLookBackScanItems; ++i) {
+      int64_t idx = i * wg_size + local_id;
+      local_data_[idx] =
+          tile_start + idx < N_ ? static_cast<T>(first_[tile_start + idx]) : 0;
+    }
+    item_id.barrier(sycl_local_fence);
+
+    T items[kLookBackScanItems];
+    T thread_sum = 0;
+#pragma unroll
+    for (int i = 0; i < kLookBackScanItems; ++i) {
+      items[i] = local_data_[local_id * kLookBackScanItems + i];
+      thread_sum += items[i];
+    }
+    T thread_prefix =
+        sycl::exclusive_scan_over_group(group, thread_sum, sycl::plus<T>());
+    T tile_aggregate =
+        sycl::group_broadcast(group, thread_prefix + thread_sum, wg_size - 1);
+
+    if (local_id == 0) {
+      T tile_prefix = init_;
+      if (tile_id == 0) {
+        state_.prefixes[0] = init_ + tile_aggregate;
+        status_ref_t(state_.status[0])
+            .store(kScanTilePrefix, sycl_mem_odr_rel);
+      } else {
+        state_.aggregates[tile_id] = tile_aggregate;
+        status_ref_t(state_.status[tile_id])
+            .store(kScanTileAggregate, sycl_mem_odr_rel);
+
+        T running = 0;
+        for (int64_t pred = tile_id - 1;; --pred) {
+          status_ref_t pred_status(state_.status[pred]);
+          uint32_t status;
+          do {
+            status = pred_status.load(sycl_mem_odr_acq);
+          } while (status == kScanTileInvalid);
+          if (status == kScanTilePrefix) {
+            running += state_.prefixes[pred];
+            break;
+          }
+          running += state_.aggregates[pred];
+        }
+        tile_prefix = running;
+        state_.prefixes[tile_id] = running + tile_aggregate;
+        status_ref_t(state_.status[tile_id])
+            .store(kScanTilePrefix, sycl_mem_odr_rel);
+      }
+      local_tile_prefix_[0] = tile_prefix;
+    }
+    item_id.barrier(sycl_local_fence);
+
+    T prefix = local_tile_prefix_[0] + thread_prefix;
+#pragma unroll
+    for (int i = 0; i < kLookBackScanItems; ++i) {
+      if (scan_type == 1) {
+        prefix += items[i];
+        local_data_[local_id * kLookBackScanItems + i] = prefix;
+      } else {
+        local_data_[local_id * kLookBackScanItems + i] = prefix;
+        prefix += items[i];
+      }
+    }
+    item_id.barrier(sycl_local_fence);
+
+#pragma unroll
+    for (int i = 0; i < kLookBackScanItems; ++i) {
+      int64_t idx = i * wg_size + local_id;
+      if (tile_start + idx < N_) {
+        d_first_[tile_start + idx] = local_data_[idx];
+      }
+    }
+  }
+
+  void sycl_ker_config_convention(sycl::handler& cgh) {
+    local_data_ =
+        sycl_local_acc_t<T>(wgroup_size_ * kLookBackScanItems, cgh);
+    local_tile_id_ = sycl_local_acc_t<uint32_t>(1, cgh);
+    local_tile_prefix_ = sycl_local_acc_t<T>(1, cgh);
+  }
+
+  LookBackScanKernelFunctor(
+      InputIt first,
+      T init,
+      int64_t N,
+      ScanTileState<T> state,
+      int64_t wgroup_size,
+      OutputIt d_first)
+      : first_(first),
+        init_(init),
+        N_(N),
+        state_(state),
+        wgroup_size_(wgroup_size),
+        d_first_(d_first),
+        local_data_(),
+        local_tile_id_(),
+        local_tile_prefix_() {}
+
+ private:
+  InputIt first_;
+  T init_;
+  int64_t N_;
+  ScanTileState<T> state_;
+  int64_t wgroup_size_;
+  OutputIt d_first_;
+  sycl_local_acc_t<T> local_data_;
+  sycl_local_acc_t<uint32_t> local_tile_id_;
+  sycl_local_acc_t<T> local_tile_prefix_;
+};
+
+} // namespace at::native::xpu::pstl
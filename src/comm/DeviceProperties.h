@@ -1,26 +1,170 @@
 #pragma once
 
 #include <ATen/xpu/XPUContext.h>
+#include <c10/util/hash.h>
+#include <c10/xpu/XPUMacros.h>
 
 #include <comm/Runtime.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <iostream>
+#include <mutex>
+#include <shared_mutex>
+#include <typeindex>
+#include <unordered_map>
 
 namespace xpu {
 namespace sycl {
 
+// Kernel specific limits on a device. Querying them requires a kernel bundle
+// lookup, which is much more expensive than the kernel submission itself for
+// small ops, so they are cached per process.
+// SYCL 2020 does not expose per-kernel local memory usage, the local memory a
+// kernel may allocate is bounded by syclLocalMemSize().
+struct KernelDeviceProperties {
+  int64_t max_work_group_size;
+  int64_t preferred_work_group_size_multiple;
+  int64_t max_sub_group_size;
+  int64_t compile_sub_group_size;
+  int64_t private_mem_size;
+};
+
+struct KernelPropertiesCacheStats {
+  uint64_t hits;
+  uint64_t misses;
+};
+
+namespace detail {
+
+class KernelPropertiesCache {
+ public:
+  using key_t = std::pair<std::type_index, at::DeviceIndex>;
+
+  static KernelPropertiesCache& instance() {
+    static KernelPropertiesCache cache;
+    return cache;
+  }
+
+  template <class KernelClass>
+  const KernelDeviceProperties& get(at::DeviceIndex dev_id) {
+    // Entries of the shared map for this kernel, indexed by device, so that
+    // hits take neither the lock nor a hash.
+    static std::array<
+        std::atomic<const KernelDeviceProperties*>,
+        C10_COMPILE_TIME_MAX_XPUS>
+        entries;
+    const bool indexed = dev_id >= 0 && dev_id < C10_COMPILE_TIME_MAX_XPUS;
+    if (indexed) {
+      auto* props = entries[dev_id].load(std::memory_order_acquire);
+      if (props) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return *props;
+      }
+    }
+
+    const auto& props = lookup<KernelClass>(dev_id);
+    if (indexed) {
+      entries[dev_id].store(&props, std::memory_order_release);
+    }
+    return props;
+  }
+
+  KernelPropertiesCacheStats stats() const {
+    return {
+        hits_.load(std::memory_order_relaxed),
+        misses_.load(std::memory_order_relaxed)};
+  }
+
+  void reset_stats() {
+    hits_.store(0, std::memory_order_relaxed);
+    misses_.store(0, std::memory_order_relaxed);
+  }
+
+ private:
+  struct KeyHash {
+    size_t operator()(const key_t& key) const {
+      return c10::hash_combine(key.first.hash_code(), key.second);
+    }
+  };
+
+  template <class KernelClass>
+  const KernelDeviceProperties& lookup(at::DeviceIndex dev_id) {
+    key_t key{std::type_index(typeid(KernelClass)), dev_id};
+    {
+      std::shared_lock<std::shared_mutex> lock(mutex_);
+      auto it = cache_.find(key);
+      if (it != cache_.end()) {
+        hits_.fetch_add(1, std::memory_order_relaxed);
+        return it->second;
+      }
+    }
+
+    // Query outside of the lock. Concurrent misses on the same key compute
+    // identical values, the first insertion wins.
+    auto props = query<KernelClass>(dev_id);
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    misses_.fetch_add(1, std::memory_order_relaxed);
+    // Elements of an unordered_map are not moved on rehash, the returned
+    // reference stays valid.
+    return cache_.emplace(key, props).first->second;
+  }
+
+  template <class KernelClass>
+  static KernelDeviceProperties query(at::DeviceIndex dev_id) {
+    auto q = c10::xpu::getCurrentXPUStream(dev_id).queue();
+    auto ctx = q.get_context();
+    auto dev = q.get_device();
+
+    auto kid = ::sycl::get_kernel_id<KernelClass>();
+    auto kbundle =
+        ::sycl::get_kernel_bundle<::sycl::bundle_state::executable>(ctx, {kid});
+    ::sycl::kernel k = kbundle.get_kernel(kid);
+
+    using namespace ::sycl::info;
+    KernelDeviceProperties props;
+    props.max_work_group_size =
+        k.get_info<kernel_device_specific::work_group_size>(dev);
+    props.preferred_work_group_size_multiple = k.get_info<
+        kernel_device_specific::preferred_work_group_size_multiple>(dev);
+    props.max_sub_group_size =
+        k.get_info<kernel_device_specific::max_sub_group_size>(dev);
+    props.compile_sub_group_size =
+        k.get_info<kernel_device_specific::compile_sub_group_size>(dev);
+    props.private_mem_size =
+        k.get_info<kernel_device_specific::private_mem_size>(dev);
+    return props;
+  }
+
+  KernelPropertiesCache() = default;
+
+  std::shared_mutex mutex_;
+  std::unordered_map<key_t, KernelDeviceProperties, KeyHash> cache_;
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+};
+
+} // namespace detail
+
 template <class KernelClass>
-static int64_t syclMaxWorkGroupSize(
+static const KernelDeviceProperties& syclKernelProperties(
     at::DeviceIndex dev_id = at::xpu::getDeviceIndexOfCurrentQueue()) {
-  auto q = c10::xpu::getCurrentXPUStream(dev_id).queue();
-  auto ctx = q.get_context();
-  auto dev = q.get_device();
+  return detail::KernelPropertiesCache::instance().get<KernelClass>(dev_id);
+}
+
+// Hit/miss counters of the kernel properties cache, for profiling.
+static inline KernelPropertiesCacheStats syclKernelPropertiesCacheStats() {
+  return detail::KernelPropertiesCache::instance().stats();
+}
 
-  auto kid = ::sycl::get_kernel_id<KernelClass>();
-  auto kbundle =
-      ::sycl::get_kernel_bundle<::sycl::bundle_state::executable>(ctx, {kid});
+static inline void syclResetKernelPropertiesCacheStats() {
+  detail::KernelPropertiesCache::instance().reset_stats();
+}
 
-  ::sycl::kernel k = kbundle.get_kernel(kid);
-  return k.get_info<::sycl::info::kernel_device_specific::work_group_size>(dev);
+template <class KernelClass>
+static int64_t syclMaxWorkGroupSize(
+    at::DeviceIndex dev_id = at::xpu::getDeviceIndexOfCurrentQueue()) {
+  return syclKernelProperties<KernelClass>(dev_id).max_work_group_size;
 }
 
 template <class KernelClass>
@@ -60,6 +204,15 @@ static inline int64_t syclMinSubGroupSize(
   return min_val;
 }
 
+static inline bool syclHasSubGroupSize(
+    int64_t size,
+    at::DeviceIndex dev_id = at::xpu::getDeviceIndexOfCurrentQueue()) {
+  auto* dev_prop = at::xpu::getDeviceProperties(dev_id);
+  auto subgroup_sizes = dev_prop->sub_group_sizes;
+  return std::find(subgroup_sizes.begin(), subgroup_sizes.end(), size) !=
+      subgroup_sizes.end();
+}
+
 static inline int64_t syclMaxComputeUnitSize(
     at::DeviceIndex dev_id = at::xpu::getDeviceIndexOfCurrentQueue()) {
   auto* dev_prop = at::xpu::getDeviceProperties(dev_id);
@@ -0,0 +1,553 @@
+// Host-side overhead of SYCL kernel submission.
+//
+// Measures, on the SYCL device selected as described in sycl_device.hpp,
+// which is the CPU device unless --device says otherwise:
+// - the submission helpers of comm/SYCLHelpers.h,
+// - equivalents of the ATen XPU launchers, i.e. the vectorized elementwise
+//   launch of Loops.h (default and persistent grid) and multi_tensor_apply of
+//   MultiTensorApply.h (metadata as kernel arguments and in device memory).
+//   They submit kernels with the tile loops, argument sizes and metadata
+//   budgets of the launchers, and size grids from the device like the
+//   launchers do.
+//
+// Built as a part of PyTorch, with BENCH_ATEN_LAUNCHERS defined, it also
+// checks the mirrored budgets against the library and times the launchers
+// themselves, gpu_kernel and multi_tensor_apply. These submit to the current
+// XPU stream, so they need an XPU device and are skipped without one. On CI
+// machines without a GPU, the equivalents are the launch latency guard.
+//
+// Usage: bench_sycl_kernel_submit [--iters=N] [--numel=N] [--filter=STR]
+//                                 [--device=SPEC]
+//
+// "submit ns/launch" is the host time spent in submission, and "launches/s"
+// includes waiting for the queue to drain, i.e. the sustained launch rate.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <comm/SYCLHelpers.h>
+
+#ifdef BENCH_ATEN_LAUNCHERS
+#include <ATen/ATen.h>
+#include <ATen/native/xpu/sycl/ForeachFunctors.h>
+#include <ATen/native/xpu/sycl/Loops.h>
+#include <ATen/native/xpu/sycl/MultiTensorApply.h>
+#include <c10/xpu/XPUFunctions.h>
+#endif
+
+#include "sycl_device.hpp"
+
+namespace {
+
+// Launch parameters of Loops.h and MultiTensorApply.h for float tensors.
+namespace launcher {
+
+// 16 bytes per vector.
+constexpr int kVecSize = 4;
+constexpr int kElementPerThread = 128;
+constexpr int kArgsAddressMetaBytes = 768;
+constexpr int kArgsWGMetaBytes = 768;
+constexpr int kMaxArgsLaunches = 8;
+
+struct AddressMeta {
+  void* addresses[3];
+  uint32_t numel_to_tensor;
+};
+
+struct WGMeta {
+  uint32_t wg_to_tensor;
+  uint32_t wg_to_chunk;
+};
+
+constexpr int kMaxTensors = kArgsAddressMetaBytes / sizeof(AddressMeta);
+constexpr int kMaxWGs = kArgsWGMetaBytes / sizeof(WGMeta);
+
+} // namespace launcher
+
+#ifdef BENCH_ATEN_LAUNCHERS
+static_assert(
+    launcher::kElementPerThread == at::native::xpu::kElementPerThread &&
+    launcher::kMaxArgsLaunches == at::native::xpu::kMaxArgsLaunches);
+static_assert(
+    launcher::kMaxTensors ==
+    at::native::xpu::TLMetaForAddressArgs<
+        at::native::xpu::TLMetaForAddress<3>>::kMaxTensors);
+static_assert(launcher::kMaxWGs == at::native::xpu::TLMetaForWGArgs::kMaxWGs);
+#endif
+
+struct RangeKernel {
+  void operator()(sycl::item<1> item) const {
+    out_[item] = static_cast<float>(item.get_linear_id());
+  }
+  RangeKernel(float* out) : out_(out) {}
+
+ private:
+  float* out_;
+};
+
+struct NdRangeKernel {
+  void operator()(sycl::nd_item<1> item) const {
+    auto id = item.get_global_linear_id();
+    if (id < numel_) {
+      out_[id] = static_cast<float>(id);
+    }
+  }
+  NdRangeKernel(float* out, int64_t numel) : out_(out), numel_(numel) {}
+
+ private:
+  float* out_;
+  int64_t numel_;
+};
+
+struct SlmKernel : public __SYCL_KER_CONFIG_CONVENTION__ {
+  void operator()(sycl::nd_item<1> item) const {
+    auto lid = item.get_local_id(0);
+    auto id = item.get_global_linear_id();
+    slm_[lid] = id < numel_ ? static_cast<float>(id) : 0.f;
+    sycl::group_barrier(item.get_group());
+    if (id < numel_) {
+      out_[id] = slm_[item.get_local_range(0) - lid - 1];
+    }
+  }
+  void sycl_ker_config_convention(sycl::handler& cgh) {
+    slm_ = sycl_local_acc_t<float>(wg_size_, cgh);
+  }
+  SlmKernel(float* out, int64_t numel, int64_t wg_size)
+      : out_(out), numel_(numel), wg_size_(wg_size), slm_() {}
+
+ private:
+  float* out_;
+  int64_t numel_;
+  int64_t wg_size_;
+  sycl_local_acc_t<float> slm_;
+};
+
+// Elementwise out = a * x + y, vectorized and looping over tiles as
+// VectorizedElementwiseKernel does.
+struct VectorizedKernel {
+  void operator()(sycl::nd_item<1> item) const {
+    using vec_t = sycl::vec<float, launcher::kVecSize>;
+    int tile = item.get_local_range(0) * launcher::kVecSize;
+    int num_tiles = numel_ / tile + (numel_ % tile != 0);
+    for (int grp = item.get_group(0); grp < num_tiles;
+         grp += item.get_group_range(0)) {
+      int base = grp * tile + item.get_local_id(0) * launcher::kVecSize;
+      if (base + launcher::kVecSize <= numel_) {
+        vec_t x = *reinterpret_cast<const vec_t*>(x_ + base);
+        vec_t y = *reinterpret_cast<const vec_t*>(y_ + base);
+        *reinterpret_cast<vec_t*>(out_ + base) = a_ * x + y;
+      } else {
+        for (int i = base; i < numel_; i++) {
+          out_[i] = a_ * x_[i] + y_[i];
+        }
+      }
+    }
+  }
+  VectorizedKernel(
+      float* out,
+      const float* x,
+      const float* y,
+      float a,
+      int numel)
+      : out_(out), x_(x), y_(y), a_(a), numel_(numel) {}
+
+ private:
+  float* out_;
+  const float* x_;
+  const float* y_;
+  float a_;
+  int numel_;
+};
+
+// out = x + y over a chunk of a tensor of a list.
+inline void multi_tensor_add(
+    const launcher::AddressMeta& addr,
+    uint32_t chunk,
+    int64_t chunk_size,
+    sycl::nd_item<1> item) {
+  auto x = static_cast<const float*>(addr.addresses[0]);
+  auto y = static_cast<const float*>(addr.addresses[1]);
+  auto out = static_cast<float*>(addr.addresses[2]);
+  int64_t end = std::min<int64_t>(
+      addr.numel_to_tensor, (int64_t)(chunk + 1) * chunk_size);
+  for (int64_t i = chunk * chunk_size + item.get_local_id(0); i < end;
+       i += item.get_local_range(0)) {
+    out[i] = x[i] + y[i];
+  }
+}
+
+// Metadata passed by value, like TLMetaForAddressArgs and TLMetaForWGArgs.
+struct ArgsMeta {
+  launcher::AddressMeta address[launcher::kMaxTensors];
+  uint32_t start_tensor;
+  launcher::WGMeta wg[launcher::kMaxWGs];
+};
+
+struct MultiTensorArgsKernel {
+  void operator()(sycl::nd_item<1> item) const {
+    const auto& wg = meta_.wg[item.get_group(0)];
+    multi_tensor_add(
+        meta_.address[wg.wg_to_tensor - meta_.start_tensor],
+        wg.wg_to_chunk,
+        chunk_size_,
+        item);
+  }
+  MultiTensorArgsKernel(const ArgsMeta& meta, int64_t chunk_size)
+      : meta_(meta), chunk_size_(chunk_size) {}
+
+ private:
+  ArgsMeta meta_;
+  int64_t chunk_size_;
+};
+
+// The same update with metadata staged in device memory.
+struct MultiTensorDeviceMetaKernel {
+  void operator()(sycl::nd_item<1> item) const {
+    const auto& wg = wg_meta_[item.get_group(0)];
+    multi_tensor_add(
+        address_meta_[wg.wg_to_tensor], wg.wg_to_chunk, chunk_size_, item);
+  }
+  MultiTensorDeviceMetaKernel(
+      const launcher::AddressMeta* address_meta,
+      const launcher::WGMeta* wg_meta,
+      int64_t chunk_size)
+      : address_meta_(address_meta),
+        wg_meta_(wg_meta),
+        chunk_size_(chunk_size) {}
+
+ private:
+  const launcher::AddressMeta* address_meta_;
+  const launcher::WGMeta* wg_meta_;
+  int64_t chunk_size_;
+};
+
+#ifdef BENCH_ATEN_LAUNCHERS
+// out = a * x + y.
+struct AxpyFunctor {
+  float operator()(float x, float y) const {
+    return a_ * x + y;
+  }
+  AxpyFunctor(float a) : a_(a) {}
+
+ private:
+  float a_;
+};
+
+struct Options {
+  int64_t iters = 10000;
+  int64_t numel = 4096;
+  std::string filter;
+};
+
+Options parse_options(int argc, char* argv[]) {
+  Options opts;
+  for (int i = 1; i < argc; i++) {
+    std::string arg(argv[i]);
+    auto value = [&](const char* key) -> const char* {
+      size_t len = strlen(key);
+      return arg.compare(0, len, key) == 0 ? arg.c_str() + len : nullptr;
+    };
+    if (auto v = value("--iters=")) {
+      opts.iters = std::max<int64_t>(1, atoll(v));
+    } else if (auto v = value("--numel=")) {
+      opts.numel = std::max<int64_t>(1, atoll(v));
+    } else if (auto v = value("--filter=")) {
+      opts.filter = v;
+    } else if (value(sycl_test::kDeviceArg)) {
+      continue;
+    } else {
+      fprintf(
+          stderr, "bench_sycl_kernel_submit: unknown option %s\n", argv[i]);
+      exit(1);
+    }
+  }
+  return opts;
+}
+
+void run_bench(
+    const Options& opts,
+    sycl::queue& q,
+    const char* name,
+    const std::function<void()>& submit) {
+  if (!opts.filter.empty() &&
+      std::string(name).find(opts.filter) == std::string::npos) {
+    return;
+  }
+  const int64_t warmup = std::min<int64_t>(opts.iters, 100);
+  for (int64_t i = 0; i < warmup; i++) {
+    submit();
+  }
+  q.wait();
+
+  auto start = std::chrono::steady_clock::now();
+  for (int64_t i = 0; i < opts.iters; i++) {
+    submit();
+  }
+  auto submitted = std::chrono::steady_clock::now();
+  q.wait();
+  auto end = std::chrono::steady_clock::now();
+
+  double submit_ns =
+      std::chrono::duration<double, std::nano>(submitted - start).count();
+  double total_s = std::chrono::duration<double>(end - start).count();
+  printf(
+      "%-40s %14.1f %14.1f\n",
+      name,
+      submit_ns / opts.iters,
+      opts.iters / total_s);
+}
+
+// Work-group size of the elementwise launchers, syclMaxWorkItemsPerEU(), and
+// the work-items the device runs at once, syclMaxWorkItemsPerTile(). Devices
+// without Intel GPU info, such as the CPU device, use a 256 wide group and
+// a maximum size group per compute unit.
+std::pair<int64_t, int64_t> elementwise_launch_limits(const sycl::device& dev) {
+  auto sg_sizes = dev.get_info<sycl::info::device::sub_group_sizes>();
+  int64_t simd_width = *std::max_element(sg_sizes.begin(), sg_sizes.end());
+  if (dev.has(sycl::aspect::ext_intel_gpu_hw_threads_per_eu) &&
+      dev.has(sycl::aspect::ext_intel_gpu_eu_count)) {
+    int64_t wg_size = simd_width *
+        dev.get_info<sycl::ext::intel::info::device::gpu_hw_threads_per_eu>();
+    int64_t eu_count =
+        dev.get_info<sycl::ext::intel::info::device::gpu_eu_count>();
+    return {wg_size, eu_count * wg_size};
+  }
+  int64_t max_wg_size =
+      dev.get_info<sycl::info::device::max_work_group_size>();
+  int64_t wg_size = std::min<int64_t>(256, max_wg_size);
+  int64_t compute_units =
+      dev.get_info<sycl::info::device::max_compute_units>();
+  return {wg_size, compute_units * std::max<int64_t>(1, max_wg_size)};
+}
+
+// Equivalents of the ATen launchers, on the selected device.
+void bench_launcher_equivalents(
+    const Options& opts,
+    const sycl::device& dev,
+    sycl::queue& q) {
+  const int numel = static_cast<int>(opts.numel);
+  float* out = sycl::malloc_device<float>(numel, q);
+  float* x = sycl::malloc_device<float>(numel, q);
+  float* y = sycl::malloc_device<float>(numel, q);
+  q.fill(x, 1.f, numel);
+  q.fill(y, 2.f, numel);
+  q.wait();
+
+  printf("\nequivalents of the ATen launchers\n");
+
+  auto [wg_size, max_work_items] = elementwise_launch_limits(dev);
+  const int64_t tile = wg_size * launcher::kVecSize;
+  const int64_t num_wg = (numel + tile - 1) / tile;
+  // Persistent grids are capped at the groups the device runs at once.
+  const int64_t persistent_num_wg = std::min<int64_t>(
+      num_wg, std::max<int64_t>(max_work_items / wg_size, 1));
+  run_bench(opts, q, "launch_vectorized_kernel", [&]() {
+    sycl_kernel_submit(
+        num_wg * wg_size, wg_size, q, VectorizedKernel(out, x, y, 2.f, numel));
+  });
+  run_bench(opts, q, "launch_vectorized_kernel(persistent)", [&]() {
+    sycl_kernel_submit(
+        persistent_num_wg * wg_size,
+        wg_size,
+        q,
+        VectorizedKernel(out, x, y, 2.f, numel));
+  });
+
+  // Multi tensor apply runs groups of the kernel's maximum size over chunks
+  // of kElementPerThread elements per work-item.
+  const int64_t mta_wg_size =
+      dev.get_info<sycl::info::device::max_work_group_size>();
+  const int64_t chunk_size = mta_wg_size * launcher::kElementPerThread;
+  const int64_t chunks = (numel + chunk_size - 1) / chunk_size;
+
+  // A list that fits in the kernel argument budget, unless a single tensor
+  // has more chunks than it holds.
+  const int64_t args_tensors = std::min<int64_t>(
+      launcher::kMaxTensors, launcher::kMaxWGs / chunks);
+  ArgsMeta meta;
+  meta.start_tensor = 0;
+  if (args_tensors > 0) {
+    run_bench(opts, q, "multi_tensor_apply(kernel args)", [&]() {
+      int64_t n_wg = 0;
+      for (int64_t t = 0; t < args_tensors; t++) {
+        meta.address[t] = {{x, y, out}, static_cast<uint32_t>(numel)};
+        for (int64_t c = 0; c < chunks; c++) {
+          meta.wg[n_wg++] = {
+              static_cast<uint32_t>(t), static_cast<uint32_t>(c)};
+        }
+      }
+      sycl_kernel_submit(
+          n_wg * mta_wg_size,
+          mta_wg_size,
+          q,
+          MultiTensorArgsKernel(meta, chunk_size));
+    });
+  }
+
+  // A list needing more than kMaxArgsLaunches launches, whose metadata is
+  // filled in pinned memory and copied to the device on every call.
+  const int64_t meta_tensors =
+      launcher::kMaxTensors * (launcher::kMaxArgsLaunches + 1);
+  const int64_t meta_wgs = meta_tensors * chunks;
+  auto* host_address =
+      sycl::malloc_host<launcher::AddressMeta>(meta_tensors, q);
+  auto* host_wg = sycl::malloc_host<launcher::WGMeta>(meta_wgs, q);
+  auto* address_meta =
+      sycl::malloc_device<launcher::AddressMeta>(meta_tensors, q);
+  auto* wg_meta = sycl::malloc_device<launcher::WGMeta>(meta_wgs, q);
+  run_bench(opts, q, "multi_tensor_apply(device meta)", [&]() {
+    int64_t n_wg = 0;
+    for (int64_t t = 0; t < meta_tensors; t++) {
+      host_address[t] = {{x, y, out}, static_cast<uint32_t>(numel)};
+      for (int64_t c = 0; c < chunks; c++) {
+        host_wg[n_wg++] = {static_cast<uint32_t>(t), static_cast<uint32_t>(c)};
+      }
+    }
+    q.memcpy(
+        address_meta, host_address, meta_tensors * sizeof(*host_address));
+    q.memcpy(wg_meta, host_wg, meta_wgs * sizeof(*host_wg));
+    sycl_kernel_submit(
+        meta_wgs * mta_wg_size,
+        mta_wg_size,
+        q,
+        MultiTensorDeviceMetaKernel(address_meta, wg_meta, chunk_size));
+  });
+
+  sycl::free(host_address, q);
+  sycl::free(host_wg, q);
+  sycl::free(address_meta, q);
+  sycl::free(wg_meta, q);
+  sycl::free(out, q);
+  sycl::free(x, q);
+  sycl::free(y, q);
+}
+
+// The ATen launchers, on the current XPU stream.
+void bench_aten_launchers(const Options& opts) {
+  using namespace at::native::xpu;
+  auto& q = at::xpu::getCurrentSYCLQueue();
+  auto options = at::TensorOptions().device(at::kXPU).dtype(at::kFloat);
+  auto out = at::empty({opts.numel}, options);
+  auto x = at::ones({opts.numel}, options);
+  auto y = at::full({opts.numel}, 2.f, options);
+  q.wait();
+
+  printf(
+      "\ndevice: xpu:%d (ATen launchers)\n",
+      static_cast<int>(c10::xpu::current_device()));
+
+  auto iter = at::TensorIteratorConfig()
+                  .add_output(out)
+                  .add_const_input(x)
+                  .add_const_input(y)
+                  .build();
+  run_bench(opts, q, "gpu_kernel(vectorized)", [&]() {
+    gpu_kernel(iter, AxpyFunctor(2.f));
+  });
+  run_bench(opts, q, "gpu_kernel(vectorized, persistent)", [&]() {
+    gpu_kernel(iter, AxpyFunctor(2.f), /*persistent=*/true);
+  });
+
+  // A list that fits in the kernel argument budget, and one that needs more
+  // than kMaxArgsLaunches launches and stages its metadata in device memory.
+  using TLA = TLMetaForAddressArgs<TLMetaForAddress<3>>;
+  const std::pair<const char*, int64_t> lists[] = {
+      {"multi_tensor_apply(kernel args)", TLA::kMaxTensors},
+      {"multi_tensor_apply(device meta)",
+       TLA::kMaxTensors * (kMaxArgsLaunches + 1)}};
+  for (const auto& [name, num_tensors] : lists) {
+    std::vector<std::vector<at::Tensor>> tensor_lists(3);
+    for (int64_t t = 0; t < num_tensors; t++) {
+      tensor_lists[0].push_back(x);
+      tensor_lists[1].push_back(y);
+      tensor_lists[2].push_back(at::empty_like(out));
+    }
+    run_bench(opts, q, name, [&]() {
+      multi_tensor_apply<3>(
+          tensor_lists,
+          BinaryOpListAlphaFunctor<
+              float,
+              /* depth */ 3,
+              /* r_args_depth */ 2,
+              /* res_arg_index */ 2>(),
+          std::plus<float>(),
+          1.f);
+    });
+  }
+}
+#endif
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  Options opts = parse_options(argc, argv);
+  sycl::device dev =
+      sycl_test::select_device(argc, argv, sycl_test::Prefer::cpu);
+  sycl::queue q(dev, sycl::property::queue::in_order());
+
+  const int64_t numel = opts.numel;
+  const int64_t wg_size = std::min<int64_t>(
+      256, dev.get_info<sycl::info::device::max_work_group_size>());
+
+  float* out = sycl::malloc_device<float>(numel, q);
+
+  printf(
+      "device: %s\nnumel: %lld, iters: %lld\n\n%-40s %14s %14s\n",
+      sycl_test::device_description(dev).c_str(),
+      (long long)numel,
+      (long long)opts.iters,
+      "kernel",
+      "submit ns/launch",
+      "launches/s");
+
+  const int64_t num_wg = (numel + wg_size - 1) / wg_size;
+  const int64_t global_range = num_wg * wg_size;
+
+  run_bench(opts, q, "sycl_kernel_submit(range)", [&]() {
+    sycl_kernel_submit(sycl::range<1>(numel), q, RangeKernel(out));
+  });
+  run_bench(opts, q, "sycl_kernel_submit(nd_range)", [&]() {
+    sycl_kernel_submit(
+        sycl::range<1>(global_range),
+        sycl::range<1>(wg_size),
+        q,
+        NdRangeKernel(out, numel));
+  });
+  run_bench(opts, q, "sycl_kernel_submit(int64)", [&]() {
+    sycl_kernel_submit(global_range, wg_size, q, NdRangeKernel(out, numel));
+  });
+  run_bench(opts, q, "sycl_kernel_submit(nd_range, slm)", [&]() {
+    sycl_kernel_submit(
+        sycl::range<1>(global_range),
+        sycl::range<1>(wg_size),
+        q,
+        SlmKernel(out, numel, wg_size));
+  });
+  run_bench(opts, q, "sycl_kernel_submit(int64, slm)", [&]() {
+    sycl_kernel_submit(
+        global_range, wg_size, q, SlmKernel(out, numel, wg_size));
+  });
+
+  sycl::free(out, q);
+
+  bench_launcher_equivalents(opts, dev, q);
+
+#ifdef BENCH_ATEN_LAUNCHERS
+  if (c10::xpu::device_count() == 0) {
+    printf(
+        "\nno XPU device, gpu_kernel and multi_tensor_apply need one and are "
+        "skipped\n");
+    return 0;
+  }
+  bench_aten_launchers(opts);
+#endif
+  return 0;
+}
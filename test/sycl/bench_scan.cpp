@@ -0,0 +1,330 @@
+// Device scan of pstl::inclusive_scan, three-pass Kogge-Stone with carries
+// versus single-pass decoupled look-back, over 1K to 1G int32 elements.
+//
+// Usage: bench_sycl_scan [--max-numel=N] [--device=SPEC]
+//
+// The device is selected as described in sycl_device.hpp. Bandwidth counts
+// one read and one write of each element, i.e. the traffic of a single pass.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <ATen/native/xpu/sycl/pstl/ScanKernels.h>
+
+#include "sycl_device.hpp"
+
+using namespace at::native::xpu::pstl;
+
+namespace {
+
+using scalar_t = int32_t;
+
+// Kernels of the three-pass scan that pstl::inclusive_scan used before the
+// look-back scan, kept as the baseline of the benchmark.
+template <int scan_type, class InputIt, class OutputIt, class T>
+struct KSScanWithCarrierKernelFunctor : public __SYCL_KER_CONFIG_CONVENTION__ {
+  void operator()(sycl::nd_item<1> item_id) const {
+    auto local_id = item_id.get_local_linear_id();
+    auto global_id = item_id.get_global_linear_id();
+    auto group_id = item_id.get_group_linear_id();
+
+    // initialize local_input
+    auto cur_init = (group_id == 0 ? init_ : 0);
+    if (global_id < N_) {
+      if (scan_type == 1) {
+        local_scan_[local_id] = first_[global_id];
+      } else {
+        if (local_id > 0)
+          local_scan_[local_id] = first_[global_id - 1];
+        else
+          local_scan_[local_id] = 0;
+      }
+      if (local_id == 0)
+        local_scan_[local_id] += cur_init;
+      if (local_id == wgroup_size_ - 1) {
+        carry_ptr_[group_id] = first_[global_id];
+      }
+    }
+    item_id.barrier(sycl_local_fence);
+
+    // body of KS algo
+    for (auto __k = 1; __k < wgroup_size_; __k <<= 1) {
+      auto tmp = (local_id >= __k) ? local_scan_[local_id - __k] : 0;
+      item_id.barrier(sycl_local_fence);
+      local_scan_[local_id] += tmp;
+      item_id.barrier(sycl_local_fence);
+    }
+
+    // flush result into dst
+    if (global_id < N_) {
+      d_first_[global_id] = local_scan_[local_id];
+    }
+    if (local_id == wgroup_size_ - 1) {
+      if (scan_type == 1)
+        carry_ptr_[group_id] = local_scan_[local_id];
+      else
+        carry_ptr_[group_id] += local_scan_[local_id];
+    }
+  }
+
+  void sycl_ker_config_convention(sycl::handler& cgh) {
+    local_scan_ = sycl_local_acc_t<T>(wgroup_size_, cgh);
+  }
+
+  KSScanWithCarrierKernelFunctor(
+      InputIt first,
+      T init,
+      int64_t N,
+      T* carry_ptr,
+      int64_t wgroup_size,
+      OutputIt d_first)
+      : first_(first),
+        init_(init),
+        N_(N),
+        carry_ptr_(carry_ptr),
+        wgroup_size_(wgroup_size),
+        d_first_(d_first),
+        local_scan_() {}
+
+ private:
+  InputIt first_;
+  T init_;
+  int64_t N_;
+  T* carry_ptr_;
+  int64_t wgroup_size_;
+  OutputIt d_first_;
+  sycl_local_acc_t<T> local_scan_;
+};
+
+template <class OutputIt, class T>
+struct ScanAccumulateKernelFunctor : public __SYCL_KER_CONFIG_CONVENTION__ {
+  void operator()(sycl::nd_item<1> item_id) const {
+    auto local_id = item_id.get_local_linear_id();
+    auto global_id = item_id.get_global_linear_id();
+    auto group_id = item_id.get_group_linear_id();
+
+    if (local_id == 0)
+      local_carry_[0] = carry_ptr_[group_id];
+    item_id.barrier(sycl_local_fence);
+
+    if (global_id < N_) {
+      d_first_[global_id] += local_carry_[0];
+    }
+  }
+
+  void sycl_ker_config_convention(sycl::handler& cgh) {
+    local_carry_ = sycl_local_acc_t<T>(1, cgh);
+    return;
+  }
+
+  ScanAccumulateKernelFunctor(OutputIt d_first, T* carry_ptr, int64_t N)
+      : local_carry_(), d_first_(d_first), carry_ptr_(carry_ptr), N_(N) {}
+
+ private:
+  sycl_local_acc_t<T> local_carry_;
+  OutputIt d_first_;
+  T* carry_ptr_;
+  int64_t N_;
+};
+
+void three_pass_scan(
+    sycl::queue& q,
+    scalar_t* first,
+    int64_t N,
+    scalar_t* d_first,
+    scalar_t init,
+    int64_t wg_size,
+    bool inclusive,
+    scalar_t** carries) {
+  if (N <= wg_size) {
+    if (inclusive) {
+      sycl_kernel_submit(
+          sycl::range<1>(N),
+          sycl::range<1>(N),
+          q,
+          KSScanKernelFunctor<1, scalar_t*, scalar_t*, scalar_t>(
+              first, init, N, d_first));
+    } else {
+      sycl_kernel_submit(
+          sycl::range<1>(N),
+          sycl::range<1>(N),
+          q,
+          KSScanKernelFunctor<0, scalar_t*, scalar_t*, scalar_t>(
+              first, init, N, d_first));
+    }
+    return;
+  }
+  int64_t ngroups = (N + wg_size - 1) / wg_size;
+  scalar_t* carry = carries[0];
+  if (inclusive) {
+    sycl_kernel_submit(
+        sycl::range<1>(ngroups * wg_size),
+        sycl::range<1>(wg_size),
+        q,
+        KSScanWithCarrierKernelFunctor<1, scalar_t*, scalar_t*, scalar_t>(
+            first, init, N, carry, wg_size, d_first));
+  } else {
+    sycl_kernel_submit(
+        sycl::range<1>(ngroups * wg_size),
+        sycl::range<1>(wg_size),
+        q,
+        KSScanWithCarrierKernelFunctor<0, scalar_t*, scalar_t*, scalar_t>(
+            first, init, N, carry, wg_size, d_first));
+  }
+  three_pass_scan(q, carry, ngroups, carry, 0, wg_size, false, carries + 1);
+  sycl_kernel_submit(
+      sycl::range<1>(ngroups * wg_size),
+      sycl::range<1>(wg_size),
+      q,
+      ScanAccumulateKernelFunctor<scalar_t*, scalar_t>(d_first, carry, N));
+}
+
+// Carry buffers of each recursion level of three_pass_scan.
+std::vector<scalar_t*> alloc_carries(
+    sycl::queue& q,
+    int64_t N,
+    int64_t wg_size) {
+  std::vector<scalar_t*> carries;
+  while (N > wg_size) {
+    N = (N + wg_size - 1) / wg_size;
+    carries.push_back(sycl::malloc_device<scalar_t>(N, q));
+  }
+  return carries;
+}
+
+void look_back_scan(
+    sycl::queue& q,
+    scalar_t* first,
+    int64_t N,
+    scalar_t* d_first,
+    scalar_t init,
+    int64_t wg_size,
+    void* workspace) {
+  int64_t ntiles = (N + wg_size * kLookBackScanItems - 1) /
+      (wg_size * kLookBackScanItems);
+  q.memset(workspace, 0, ScanTileState<scalar_t>::status_bytes(ntiles));
+  sycl_kernel_submit(
+      sycl::range<1>(ntiles * wg_size),
+      sycl::range<1>(wg_size),
+      q,
+      LookBackScanKernelFunctor<1, scalar_t*, scalar_t*, scalar_t>(
+          first,
+          init,
+          N,
+          ScanTileState<scalar_t>(workspace, ntiles),
+          wg_size,
+          d_first));
+}
+
+template <typename F>
+double time_us(sycl::queue& q, int iters, F fn) {
+  fn();
+  q.wait();
+  auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iters; i++) {
+    fn();
+  }
+  q.wait();
+  auto end = std::chrono::steady_clock::now();
+  return std::chrono::duration<double, std::micro>(end - start).count() /
+      iters;
+}
+
+bool check(sycl::queue& q, const scalar_t* d_out, int64_t N) {
+  // The input is all ones, so the inclusive scan is 1..N modulo 2^32.
+  std::vector<scalar_t> out(N);
+  q.memcpy(out.data(), d_out, N * sizeof(scalar_t)).wait();
+  for (int64_t i = 0; i < N; i++) {
+    if (out[i] != static_cast<scalar_t>(i + 1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+  int64_t max_numel = int64_t(1) << 30;
+  for (int i = 1; i < argc; i++) {
+    std::string arg(argv[i]);
+    if (arg.compare(0, 12, "--max-numel=") == 0) {
+      max_numel = std::max<int64_t>(1024, atoll(arg.c_str() + 12));
+    } else if (
+        arg.compare(
+            0, strlen(sycl_test::kDeviceArg), sycl_test::kDeviceArg) != 0) {
+      fprintf(stderr, "bench_sycl_scan: unknown option %s\n", argv[i]);
+      return 1;
+    }
+  }
+  sycl::device dev = sycl_test::select_device(argc, argv);
+  sycl::queue q(dev, sycl::property::queue::in_order());
+  const int64_t wg_size = std::min<int64_t>(
+      1024, dev.get_info<sycl::info::device::max_work_group_size>());
+
+  printf(
+      "%-12s %16s %12s %16s %12s %8s\n",
+      "numel",
+      "three-pass (us)",
+      "GB/s",
+      "look-back (us)",
+      "GB/s",
+      "check");
+  for (int64_t N = 1024; N <= max_numel; N *= 4) {
+    scalar_t* in = nullptr;
+    scalar_t* out = nullptr;
+    void* workspace = nullptr;
+    std::vector<scalar_t*> carries;
+    try {
+      carries = alloc_carries(q, N, wg_size);
+      in = sycl::malloc_device<scalar_t>(N, q);
+      out = sycl::malloc_device<scalar_t>(N, q);
+      int64_t ntiles = (N + wg_size * kLookBackScanItems - 1) /
+          (wg_size * kLookBackScanItems);
+      workspace = sycl::malloc_device(
+          ScanTileState<scalar_t>::workspace_bytes(ntiles), q);
+    } catch (const sycl::exception&) {
+    }
+    if (!in || !out || !workspace ||
+        std::find(carries.begin(), carries.end(), nullptr) != carries.end()) {
+      printf("%-12lld out of device memory\n", (long long)N);
+      break;
+    }
+    q.fill(in, scalar_t(1), N).wait();
+
+    const int iters = static_cast<int>(
+        std::clamp<int64_t>((int64_t(1) << 26) / N, 3, 100));
+    double bytes = 2.0 * N * sizeof(scalar_t);
+    double three_pass = time_us(q, iters, [&]() {
+      three_pass_scan(q, in, N, out, 0, wg_size, true, carries.data());
+    });
+    bool ok = check(q, out, N);
+    q.fill(out, scalar_t(0), N).wait();
+    double look_back = time_us(q, iters, [&]() {
+      look_back_scan(q, in, N, out, 0, wg_size, workspace);
+    });
+    ok = ok && check(q, out, N);
+    printf(
+        "%-12lld %16.1f %12.1f %16.1f %12.1f %8s\n",
+        (long long)N,
+        three_pass,
+        bytes / three_pass / 1e3,
+        look_back,
+        bytes / look_back / 1e3,
+        ok ? "pass" : "FAIL");
+
+    sycl::free(in, q);
+    sycl::free(out, q);
+    sycl::free(workspace, q);
+    for (auto carry : carries) {
+      sycl::free(carry, q);
+    }
+  }
+  return 0;
+}
@@ -1,12 +1,12 @@
 #include <iostream>
 #include "simple_kernel.hpp"
 
-void test_simple_kernel() {
+void test_simple_kernel(int argc, char* argv[]) {
   int numel = 1024;
   float a[1024];
 
   // a simple sycl kernel
-  itoa(a, numel);
+  itoa(a, numel, argc, argv);
 
   bool success = true;
   for (int i = 0; i < numel; i++) {
@@ -24,6 +24,6 @@ void test_simple_kernel() {
 }
 
 int main(int argc, char* argv[]) {
-  test_simple_kernel();
+  test_simple_kernel(argc, argv);
   return 0;
 }
@@ -1,6 +1,8 @@
 #pragma once
 
-// Create an idx array on SYCL GPU device
+// Create an idx array on SYCL device
 // res      - host buffer for result
 // numel    - length of the idx array
-void itoa(float* res, int numel);
+// argc     - command line, may select the device with `--device=<spec>`,
+// argv       see sycl_device.hpp
+void itoa(float* res, int numel, int argc = 0, char* argv[] = nullptr);
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <sycl/sycl.hpp>
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Device selection of the SYCL test and benchmark harness.
+//
+// A device spec is "<backend>:<type>[:<index>]", where backend is one of
+// level_zero, opencl or *, type is one of gpu, cpu or *, and index counts the
+// matching devices, e.g. "level_zero:gpu", "opencl:cpu", "*:cpu:1". The spec
+// is taken from the `--device=<spec>` argument, else from the environment
+// variable TORCH_XPU_OPS_TEST_DEVICE. Without a spec tests use the first
+// available of Level Zero GPU, any GPU, OpenCL CPU and any CPU, so they also
+// run on build agents without a GPU. Benchmarks may prefer the CPU instead,
+// i.e. OpenCL CPU, any CPU, Level Zero GPU and any GPU, so that numbers are
+// comparable across agents unless a GPU is asked for.
+
+namespace sycl_test {
+
+static constexpr const char* kDeviceEnv = "TORCH_XPU_OPS_TEST_DEVICE";
+static constexpr const char* kDeviceArg = "--device=";
+
+inline std::string backend_name(sycl::backend backend) {
+  switch (backend) {
+    case sycl::backend::ext_oneapi_level_zero:
+      return "level_zero";
+    case sycl::backend::opencl:
+      return "opencl";
+    default: {
+      std::ostringstream os;
+      os << backend;
+      return os.str();
+    }
+  }
+}
+
+inline std::string device_type_name(const sycl::device& dev) {
+  if (dev.is_gpu()) {
+    return "gpu";
+  }
+  if (dev.is_cpu()) {
+    return "cpu";
+  }
+  return "accelerator";
+}
+
+// E.g. "level_zero:gpu Intel(R) Data Center GPU Max 1550".
+inline std::string device_description(const sycl::device& dev) {
+  return backend_name(dev.get_backend()) + ":" + device_type_name(dev) + " " +
+      dev.get_info<sycl::info::device::name>();
+}
+
+inline std::vector<sycl::device> find_devices(
+    const std::string& backend,
+    const std::string& type) {
+  std::vector<sycl::device> devices;
+  for (const auto& platform : sycl::platform::get_platforms()) {
+    if (backend != "*" && backend_name(platform.get_backend()) != backend) {
+      continue;
+    }
+    for (const auto& dev : platform.get_devices()) {
+      if (type == "*" || device_type_name(dev) == type) {
+        devices.push_back(dev);
+      }
+    }
+  }
+  return devices;
+}
+
+// Returns the spec given by `--device=`, or by the environment, or an empty
+// string.
+inline std::string device_spec(int argc = 0, char* argv[] = nullptr) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg(argv[i]);
+    if (arg.compare(0, strlen(kDeviceArg), kDeviceArg) == 0) {
+      return arg.substr(strlen(kDeviceArg));
+    }
+  }
+  const char* env = std::getenv(kDeviceEnv);
+  return env ? std::string(env) : std::string();
+}
+
+enum class Prefer { gpu, cpu };
+
+inline sycl::device select_device(
+    const std::string& spec,
+    Prefer prefer = Prefer::gpu) {
+  if (spec.empty()) {
+    const char* gpu_first[][2] = {
+        {"level_zero", "gpu"}, {"*", "gpu"}, {"opencl", "cpu"}, {"*", "cpu"}};
+    const char* cpu_first[][2] = {
+        {"opencl", "cpu"}, {"*", "cpu"}, {"level_zero", "gpu"}, {"*", "gpu"}};
+    const auto& preferences = prefer == Prefer::gpu ? gpu_first : cpu_first;
+    for (const auto& pref : preferences) {
+      auto devices = find_devices(pref[0], pref[1]);
+      if (!devices.empty()) {
+        return devices[0];
+      }
+    }
+    throw std::runtime_error("test_sycl: no SYCL GPU or CPU device found ...");
+  }
+
+  std::vector<std::string> fields;
+  std::istringstream iss(spec);
+  std::string field;
+  while (std::getline(iss, field, ':')) {
+    fields.push_back(field);
+  }
+  if (fields.size() < 2 || fields.size() > 3) {
+    throw std::runtime_error(
+        "test_sycl: invalid device spec '" + spec +
+        "', expected <backend>:<type>[:<index>]");
+  }
+  size_t index = fields.size() == 3 ? std::stoul(fields[2]) : 0;
+  auto devices = find_devices(fields[0], fields[1]);
+  if (index >= devices.size()) {
+    throw std::runtime_error(
+        "test_sycl: no SYCL device matches spec '" + spec + "' ...");
+  }
+  return devices[index];
+}
+
+// Selects the device and reports it, so that results can be attributed to
+// the device they were measured on.
+inline sycl::device select_device(
+    int argc = 0,
+    char* argv[] = nullptr,
+    Prefer prefer = Prefer::gpu) {
+  auto dev = select_device(device_spec(argc, argv), prefer);
+  std::cout << "test_sycl: device: " << device_description(dev) << std::endl;
+  return dev;
+}
+
+} // namespace sycl_test
@@ -3023,5 +3023,9 @@ res += launch_test("nn/test_module_hooks_xpu.py")
 
 res += launch_test("nn/test_parametrization_xpu.py")
 
+# test_optim, fused optimizer kernels only
+
+res += launch_test("test_optim_xpu.py", exe_list=("fused",))
+
 exit_code = os.WEXITSTATUS(res)
 sys.exit(exit_code)